@@ -0,0 +1,56 @@
+#pragma once
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+namespace Graph_implementation{
+
+/*
+ * Memory for algorithm temporaries.
+ * The algorithms build their working containers (stacks, heaps, visited bits, residual arrays)
+ * as std::pmr containers on scratch_resource(): the global heap, unless the calling thread has
+ * opened a ScratchScope over another resource, typically a std::pmr::monotonic_buffer_resource
+ * owned by one job (see Q_9/pipeline/Job.hpp). Such an arena is thread-private, needs no locking,
+ * and everything the job allocated is released at once when the arena is destroyed.
+ *
+ * Only temporaries use the scratch resource; results are returned in plain std containers, so
+ * nothing handed back to the caller points into an arena. Objects built inside a scope that keep
+ * pmr members (ResidualNetwork) must not outlive the scope.
+ */
+namespace arena{
+
+inline std::pmr::memory_resource*& thread_resource_() {
+    thread_local std::pmr::memory_resource* current = nullptr;
+    return current;
+}
+
+// Resource for scratch allocations on this thread.
+inline std::pmr::memory_resource* scratch_resource() {
+    std::pmr::memory_resource* r = thread_resource_();
+    return r ? r : std::pmr::get_default_resource();
+}
+
+// Routes this thread's scratch allocations to 'mr' until destroyed (nullptr = global heap).
+// Scopes nest; the previous resource is restored on exit.
+class ScratchScope{
+   public:
+    explicit ScratchScope(std::pmr::memory_resource* mr) : prev_(thread_resource_()) { thread_resource_() = mr; }
+    ~ScratchScope() { thread_resource_() = prev_; }
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+   private:
+    std::pmr::memory_resource* prev_;
+};
+
+template <typename X> using scratch_vector = std::pmr::vector<X>;
+
+// n copies of 'fill' on the current scratch resource.
+template <typename X>
+scratch_vector<X> scratch_array(std::size_t n = 0, const X& fill = X{}) {
+    return scratch_vector<X>(n, fill, scratch_resource());
+}
+
+}; // namespace arena
+
+}; // namespace Graph_implementation
@@ -0,0 +1,900 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <stack>
+#include <functional>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <tuple>
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <random>
+
+#include "Edge.hpp"
+#include "VertexIndex.hpp"
+#include "EdgeList.hpp"
+#include "Column.hpp"
+#include "UnionFind.hpp"
+#include "Parallel.hpp"
+
+namespace Graph_implementation{
+
+// Strongly connected components algorithm for directed graphs:
+//   kosaraju : two DFS passes, the second over a transposed copy of the arcs
+//   tarjan   : one iterative DFS over the adjacency as stored, O(V) extra memory
+//   parallel : trimming, forward–backward search and label propagation on several threads
+enum class SccEngine{ kosaraju, tarjan, parallel };
+
+// "kosaraju", "tarjan" or "parallel"/"fb-trim" (case-sensitive); throws std::invalid_argument otherwise.
+inline SccEngine parse_scc_engine(const std::string& name) {
+    if (name == "kosaraju") return SccEngine::kosaraju;
+    if (name == "tarjan") return SccEngine::tarjan;
+    if (name == "parallel" || name == "fb-trim") return SccEngine::parallel;
+    throw std::invalid_argument("Unknown SCC engine: " + name);
+}
+
+/*
+ * CSRGraph<T> is an immutable compressed-sparse-row snapshot of a Graph<T>
+ * (see Graph::freeze()).
+ * Every vertex gets a dense id 0..n-1 once (the VertexIndex of the source graph).
+ * The arcs leaving id u are targets[offsets[u] .. offsets[u+1]) with the matching
+ * weights[] entry, sorted by target id (except from_edges(..., sort_rows = false)).
+ * Undirected edges are stored in both directions, exactly like the adjacency map they come from.
+ * All the Graph facade algorithms have a version here that walks the contiguous arrays
+ * instead of hash nodes; results are reported with the original vertex labels.
+ */
+template <typename T>
+class CSRGraph{
+   public:
+    using id_type = typename VertexIndex<T>::id_type;
+    using edge_tuple = std::tuple<T, T, double>;
+    static constexpr id_type npos = VertexIndex<T>::npos;
+
+    CSRGraph() = default;
+
+    // Build from any "vertex -> iterable of (neighbor, weight)" map, e.g. Graph's adjacency map.
+    // Ids are assigned in the map's iteration order.
+    template <typename AdjacencyMap>
+    CSRGraph(const AdjacencyMap& adj, bool directed) : directed_(directed) {
+        index_.reserve(adj.size());
+        for (const auto& [u, _] : adj) index_.intern(u);
+        build_(adj);
+    }
+
+    // Build reusing an existing interning of the vertices (Graph keeps one up to date),
+    // so the snapshot ids match the graph's own dense ids.
+    template <typename AdjacencyMap>
+    CSRGraph(const AdjacencyMap& adj, const VertexIndex<T>& index, bool directed)
+        : directed_(directed), index_(index) {
+        build_(adj);
+    }
+
+    // Same, for an index kept in other containers (e.g. CowStorage): ids are replayed in order.
+    template <typename AdjacencyMap, typename Labels, typename Ids>
+    CSRGraph(const AdjacencyMap& adj, const VertexIndex<T, Labels, Ids>& index, bool directed)
+        : directed_(directed) {
+        index_.reserve(index.size());
+        for (std::size_t id = 0; id < index.size(); ++id) index_.intern(index.vertex(static_cast<id_type>(id)));
+        build_(adj);
+    }
+
+    // Assemble from ready-made columns (offsets: n+1 entries, targets sorted within each row
+    // unless rows_sorted is false), e.g. the memory-mapped arrays of a snapshot file
+    // (load_snapshot in Snapshot.hpp).
+    CSRGraph(bool directed, VertexIndex<T> index,
+             Column<std::size_t> offsets, Column<id_type> targets, Column<double> weights,
+             bool rows_sorted = true)
+        : directed_(directed), rows_sorted_(rows_sorted), index_(std::move(index)),
+          offsets_(std::move(offsets)), targets_(std::move(targets)), weights_(std::move(weights)) {}
+
+    // Build straight from an unsorted edge list, without an intermediate Graph.
+    // Ids follow first appearance in 'edges' (as Graph::add_edges assigns them); an undirected
+    // edge becomes two arcs, an undirected self-loop one. Labels are interned on the calling
+    // thread; the degree count and the scatter into rows run on parallel::thread_count() workers.
+    //   sort_rows = true : each row is sorted by target and repeated arcs keep the first weight,
+    //                      i.e. the same snapshot as Graph::add_edges(edges) + freeze().
+    //   sort_rows = false: rows keep every arc in no particular order (no per-row sort, no
+    //                      dedupe), so pass a duplicate-free list; find_arc() then scans the row.
+    static CSRGraph from_edges(const std::vector<edge_tuple>& edges, bool directed, bool sort_rows = true) {
+        CSRGraph g;
+        g.directed_ = directed;
+        g.rows_sorted_ = sort_rows;
+
+        // 1) Intern endpoints in input order
+        std::vector<std::pair<id_type, id_type>> ends(edges.size());
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            const id_type u = g.index_.intern(std::get<0>(edges[i]));
+            ends[i] = {u, g.index_.intern(std::get<1>(edges[i]))};
+        }
+        const std::size_t n = g.index_.size();
+        const std::size_t workers = parallel::thread_count(edges.size());
+        auto twin = [&](std::size_t i){ return !directed && ends[i].first != ends[i].second; };
+
+        // 2) Out-degrees, counted concurrently
+        std::vector<std::atomic<std::size_t>> cursor(n);
+        parallel::for_chunks(edges.size(), workers, [&](std::size_t b, std::size_t e, std::size_t){
+            for (std::size_t i = b; i < e; ++i) {
+                cursor[ends[i].first].fetch_add(1, std::memory_order_relaxed);
+                if (twin(i)) cursor[ends[i].second].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        // 3) Prefix sum into row starts; the counters become per-row write cursors
+        std::vector<std::size_t> offsets(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            offsets[u + 1] = offsets[u] + cursor[u].load(std::memory_order_relaxed);
+            cursor[u].store(offsets[u], std::memory_order_relaxed);
+        }
+        const std::size_t m = offsets[n];
+
+        // 4) Scatter: every worker claims slots in the rows it writes to
+        auto scatter = [&](auto&& put) {
+            parallel::for_chunks(edges.size(), workers, [&](std::size_t b, std::size_t e, std::size_t){
+                for (std::size_t i = b; i < e; ++i) {
+                    const auto [u, v] = ends[i];
+                    put(cursor[u].fetch_add(1, std::memory_order_relaxed), v, i);
+                    if (twin(i)) put(cursor[v].fetch_add(1, std::memory_order_relaxed), u, i);
+                }
+            });
+        };
+
+        if (!sort_rows) {
+            std::vector<id_type> targets(m);
+            std::vector<double> weights(m);
+            scatter([&](std::size_t a, id_type to, std::size_t i){
+                targets[a] = to;
+                weights[a] = std::get<2>(edges[i]);
+            });
+            g.offsets_ = Column<std::size_t>(std::move(offsets));
+            g.targets_ = Column<id_type>(std::move(targets));
+            g.weights_ = Column<double>(std::move(weights));
+            return g;
+        }
+
+        struct Slot { id_type to; std::size_t seq; double w; };
+        std::vector<Slot> slots(m);
+        scatter([&](std::size_t a, id_type to, std::size_t i){ slots[a] = Slot{to, i, std::get<2>(edges[i])}; });
+
+        // 5) Sort each row by (target, input position) and keep the first arc per target
+        const std::size_t row_workers = parallel::thread_count(m);
+        std::vector<std::size_t> kept(n + 1, 0);
+        parallel::for_chunks(n, row_workers, [&](std::size_t b, std::size_t e, std::size_t){
+            for (std::size_t u = b; u < e; ++u) {
+                auto first = slots.begin() + offsets[u], last = slots.begin() + offsets[u + 1];
+                std::sort(first, last, [](const Slot& x, const Slot& y){ return std::tie(x.to, x.seq) < std::tie(y.to, y.seq); });
+                kept[u + 1] = std::unique(first, last, [](const Slot& x, const Slot& y){ return x.to == y.to; }) - first;
+            }
+        });
+        std::partial_sum(kept.begin(), kept.end(), kept.begin());
+
+        // 6) Compact the surviving arcs into the final columns
+        std::vector<id_type> targets(kept[n]);
+        std::vector<double> weights(kept[n]);
+        parallel::for_chunks(n, row_workers, [&](std::size_t b, std::size_t e, std::size_t){
+            for (std::size_t u = b; u < e; ++u)
+                for (std::size_t k = kept[u], a = offsets[u]; k < kept[u + 1]; ++k, ++a) {
+                    targets[k] = slots[a].to;
+                    weights[k] = slots[a].w;
+                }
+        });
+        g.offsets_ = Column<std::size_t>(std::move(kept));
+        g.targets_ = Column<id_type>(std::move(targets));
+        g.weights_ = Column<double>(std::move(weights));
+        return g;
+    }
+
+    // ======================= Structure accessors =======================
+    bool is_directed() const { return directed_; }
+    // False only for from_edges(..., sort_rows = false) builds (and snapshots of them).
+    bool rows_sorted() const { return rows_sorted_; }
+    std::size_t vertex_count() const { return index_.size(); }
+    std::size_t arc_count() const { return targets_.size(); }
+
+    id_type id_of(const T& v) const { return index_.id_of(v); }
+    const T& vertex(id_type id) const { return index_.vertex(id); }
+    const VertexIndex<T>& vertex_index() const { return index_; }
+
+    std::size_t arc_begin(id_type u) const { return offsets_[u]; }
+    std::size_t arc_end(id_type u) const { return offsets_[u + 1]; }
+    id_type target(std::size_t arc) const { return targets_[arc]; }
+    double weight(std::size_t arc) const { return weights_[arc]; }
+    std::size_t degree(id_type u) const { return offsets_[u + 1] - offsets_[u]; }
+
+    const Column<std::size_t>& offsets() const { return offsets_; }
+    const Column<id_type>& targets() const { return targets_; }
+    const Column<double>& weights() const { return weights_; }
+
+    // Heap owned by the snapshot; arrays borrowed from a mapped file are not counted.
+    MemoryUsage memory_usage() const {
+        MemoryUsage m;
+        m.bytes = sizeof(*this);
+        m += memory::of(index_);
+        m += memory::of(offsets_);
+        m += memory::of(targets_);
+        m += memory::of(weights_);
+        return m;
+    }
+
+    // Arc index of u->v, or npos-sized sentinel (arc_count()) if absent.
+    // O(log degree) on sorted rows, a linear scan otherwise.
+    std::size_t find_arc(id_type u, id_type v) const {
+        auto first = targets_.begin() + offsets_[u];
+        auto last  = targets_.begin() + offsets_[u + 1];
+        if (!rows_sorted_) {
+            auto it = std::find(first, last, v);
+            return it != last ? static_cast<std::size_t>(it - targets_.begin()) : arc_count();
+        }
+        auto it = std::lower_bound(first, last, v);
+        return (it != last && *it == v) ? static_cast<std::size_t>(it - targets_.begin()) : arc_count();
+    }
+    bool has_arc(id_type u, id_type v) const { return find_arc(u, v) != arc_count(); }
+
+    // ======================= Euler =======================
+    bool is_eulerian() const {
+        const id_type n = static_cast<id_type>(vertex_count());
+        if (directed_) {
+            std::vector<std::size_t> in = in_degrees_();
+            for (id_type u = 0; u < n; ++u)
+                if (in[u] != degree(u)) return false;
+        } else {
+            for (id_type u = 0; u < n; ++u)
+                if (degree(u) % 2 != 0) return false;
+        }
+        return weakly_connected_nonzero_();
+    }
+
+    std::vector<T> euler_circuit() const {
+        if (vertex_count() == 0) return {};
+        if (!is_eulerian()) return {};
+
+        const id_type n = static_cast<id_type>(vertex_count());
+        id_type start = 0;
+        for (id_type u = 0; u < n; ++u) if (degree(u) > 0) { start = u; break; }
+
+        // Per-vertex cursor into its arc range; undirected arcs are consumed together with their twin
+        std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+        std::vector<char> used(directed_ ? 0 : arc_count(), 0);
+
+        std::vector<id_type> st{start};
+        std::vector<T> circuit;
+        circuit.reserve(directed_ ? arc_count() + 1 : arc_count() / 2 + 1);
+
+        while (!st.empty()) {
+            id_type u = st.back();
+            std::size_t& i = next[u];
+            if (!directed_) while (i < arc_end(u) && used[i]) ++i;
+            if (i < arc_end(u)) {
+                const id_type v = targets_[i];
+                if (!directed_) {
+                    used[i] = 1;
+                    used[find_arc(v, u)] = 1;
+                }
+                ++i;
+                st.push_back(v);
+            } else {
+                circuit.push_back(index_.vertex(u));
+                st.pop_back();
+            }
+        }
+        std::reverse(circuit.begin(), circuit.end());
+        return circuit;
+    }
+
+    // ======================= MST / Arborescence =======================
+    std::vector<Edge<T>> prims_algorithm(const T& root) const {
+        return spanning_edges(root).to_edges();
+    }
+
+    // Same tree as prims_algorithm, as (from, to, weight) columns.
+    WeightedEdgeList<T> spanning_edges(const T& root) const {
+        return directed_ ? arborescence_(root) : prim_(root);
+    }
+
+    // ======================= SCC / CC =======================
+    std::vector<std::vector<T>> kosarajus_algorithm_scc() const {
+        return directed_ ? kosaraju_() : connected_components_();
+    }
+
+    // Same, with the chosen engine for directed graphs; 'threads' is used by SccEngine::parallel
+    // and by the undirected case (0 = parallel::thread_count() of the arc count). Kosaraju and
+    // Tarjan list the components in a topological order of the condensation, the parallel
+    // engine by first vertex.
+    std::vector<std::vector<T>> strongly_connected_components(SccEngine engine = SccEngine::kosaraju,
+                                                              std::size_t threads = 0) const {
+        if (!directed_) return connected_components_(threads);
+        switch (engine) {
+            case SccEngine::tarjan:   return tarjan_();
+            case SccEngine::parallel: return parallel_scc_(threads);
+            default:                  return kosaraju_();
+        }
+    }
+
+    // Component of every id (weak components for a directed snapshot), named by its smallest id.
+    // Afforest (Sutton, Ben-Nun, Barak) on 'threads' threads (0 = parallel::thread_count() of
+    // the arc count):
+    //   1. link every vertex to its first two neighbors only and compress; on real graphs this
+    //      already assembles most of the giant component;
+    //   2. guess that component from 1024 sampled vertices and skip every vertex inside it;
+    //   3. link the remaining arcs of the other vertices and compress again.
+    // A link hooks the larger root under the smaller with compare-and-swap, so the labels do
+    // not depend on the thread count. The skip needs every arc to have its twin, so a directed
+    // snapshot links all arcs in step 3.
+    std::vector<id_type> component_labels(std::size_t threads = 0) const {
+        const std::size_t n = vertex_count();
+        if (threads == 0) threads = parallel::thread_count(arc_count());
+        constexpr auto relaxed = std::memory_order_relaxed;
+        constexpr std::size_t neighbor_rounds = 2, samples = 1024;
+
+        std::vector<std::atomic<id_type>> comp(n);
+        auto link = [&](id_type u, id_type v){
+            id_type p1 = comp[u].load(relaxed), p2 = comp[v].load(relaxed);
+            while (p1 != p2) {
+                const id_type high = std::max(p1, p2), low = std::min(p1, p2);
+                id_type p_high = comp[high].load(relaxed);
+                if (p_high == low) break;
+                if (p_high == high && comp[high].compare_exchange_strong(p_high, low, relaxed)) break;
+                p1 = comp[comp[high].load(relaxed)].load(relaxed);
+                p2 = comp[low].load(relaxed);
+            }
+        };
+        auto over_vertices = [&](auto&& f){
+            parallel::for_chunks(n, threads, [&](std::size_t b, std::size_t e, std::size_t){
+                for (std::size_t v = b; v < e; ++v) f(static_cast<id_type>(v));
+            });
+        };
+        auto compress = [&]{
+            over_vertices([&](id_type v){
+                id_type up = comp[v].load(relaxed);
+                while (up != comp[up].load(relaxed)) { up = comp[up].load(relaxed); comp[v].store(up, relaxed); }
+            });
+        };
+
+        over_vertices([&](id_type v){ comp[v].store(v, relaxed); });
+        for (std::size_t r = 0; r < neighbor_rounds; ++r) {
+            over_vertices([&](id_type v){ if (degree(v) > r) link(v, targets_[offsets_[v] + r]); });
+            compress();
+        }
+
+        id_type giant = npos;
+        if (!directed_ && n > 0) {
+            std::unordered_map<id_type, std::size_t> seen;
+            std::mt19937 rng(0x5eed);
+            std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+            std::size_t best = 0;
+            for (std::size_t i = 0; i < samples; ++i) {
+                const id_type c = comp[pick(rng)].load(relaxed);
+                if (++seen[c] > best) { best = seen[c]; giant = c; }
+            }
+        }
+        over_vertices([&](id_type v){
+            if (comp[v].load(relaxed) == giant) return;
+            for (std::size_t a = offsets_[v] + std::min(degree(v), neighbor_rounds); a < offsets_[v + 1]; ++a) link(v, targets_[a]);
+        });
+        compress();
+
+        std::vector<id_type> labels(n);
+        for (std::size_t v = 0; v < n; ++v) labels[v] = comp[v].load(relaxed);
+        return labels;
+    }
+
+    // ======================= Max-Flow (Edmonds–Karp / Dinic / push–relabel) =======================
+    double edmon_karp_algorithm(const T& source, const T& sink) const {
+        const id_type s = id_of(source), t = id_of(sink);
+        if (s == npos || t == npos || s == t) return 0.0;
+        ResidualNetwork net = residual_network();
+        return net.edmonds_karp(s, t);
+    }
+
+    // Max-flow value with the chosen engine (see FlowEngine in EdgeList.hpp); 'threads' is used
+    // by parallel_push_relabel only (0 = all hardware threads).
+    double max_flow(const T& source, const T& sink, FlowEngine engine = FlowEngine::edmonds_karp,
+                    std::size_t threads = 0) const {
+        const id_type s = id_of(source), t = id_of(sink);
+        if (s == npos || t == npos || s == t) return 0.0;
+        ResidualNetwork net = residual_network();
+        return net.max_flow(s, t, engine, threads);
+    }
+
+    // Residual network over the snapshot's ids: every arc u->v gets a paired reverse arc v->u with zero capacity.
+    // 'forward', if given, receives the residual index of every snapshot arc (by arc index).
+    ResidualNetwork residual_network(std::vector<std::size_t>* forward = nullptr) const {
+        return ResidualNetwork::from_arcs(vertex_count(), [this](auto&& f){
+            for (id_type u = 0; u < static_cast<id_type>(vertex_count()); ++u)
+                for (std::size_t a = arc_begin(u); a < arc_end(u); ++a) f(u, targets_[a], weights_[a]);
+        }, forward);
+    }
+
+    // ======================= Hamilton =======================
+    std::vector<T> hamilton_cycle(const T& start) const {
+        const id_type s = id_of(start);
+        if (s == npos) return {};
+        std::vector<id_type> path; path.reserve(vertex_count() + 1);
+        std::vector<char> vis(vertex_count(), 0);
+        path.push_back(s); vis[s] = 1;
+        if (!dfs_hamilton_(s, s, path, vis)) return {};
+
+        std::vector<T> out; out.reserve(path.size());
+        for (id_type id : path) out.push_back(index_.vertex(id));
+        return out;
+    }
+
+   private:
+    template <typename AdjacencyMap>
+    void build_(const AdjacencyMap& adj) {
+        // Count arcs per vertex, then prefix-sum into offsets
+        std::vector<std::size_t> offsets(index_.size() + 1, 0);
+        for (const auto& [u, nbrs] : adj) offsets[index_.id_of(u) + 1] = nbrs.size();
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        std::vector<id_type> targets(offsets.back());
+        std::vector<double> weights(offsets.back());
+        std::vector<std::pair<id_type, double>> row;
+        for (const auto& [u, nbrs] : adj) {
+            row.clear();
+            for (const auto& [v, w] : nbrs) row.emplace_back(index_.id_of(v), w);
+            std::sort(row.begin(), row.end(),
+                      [](const auto& a, const auto& b){ return a.first < b.first; });
+            std::size_t pos = offsets[index_.id_of(u)];
+            for (const auto& [v, w] : row) { targets[pos] = v; weights[pos] = w; ++pos; }
+        }
+        offsets_ = Column<std::size_t>(std::move(offsets));
+        targets_ = Column<id_type>(std::move(targets));
+        weights_ = Column<double>(std::move(weights));
+    }
+
+    std::vector<std::size_t> in_degrees_() const {
+        // Self-loops are not counted, matching Graph::in_degree()
+        std::vector<std::size_t> in(vertex_count(), 0);
+        for (id_type u = 0; u < vertex_count(); ++u)
+            for (std::size_t a = arc_begin(u); a < arc_end(u); ++a)
+                if (targets_[a] != u) ++in[targets_[a]];
+        return in;
+    }
+
+    // Connectivity of the non-zero-degree subgraph, ignoring arc directions (union-find over arcs)
+    bool weakly_connected_nonzero_() const {
+        const id_type n = static_cast<id_type>(vertex_count());
+        UnionFind<> sets(n);
+        std::vector<char> nonzero(n, 0);
+        for (id_type u = 0; u < n; ++u) {
+            for (std::size_t a = arc_begin(u); a < arc_end(u); ++a) {
+                const id_type v = targets_[a];
+                nonzero[u] = nonzero[v] = 1;
+                sets.unite(u, v);
+            }
+        }
+        id_type root = npos;
+        for (id_type u = 0; u < n; ++u) {
+            if (!nonzero[u]) continue;
+            if (root == npos) root = sets.find(u);
+            else if (sets.find(u) != root) return false;
+        }
+        return true;
+    }
+
+    WeightedEdgeList<T> prim_(const T& source) const {
+        // Note: if the graph is disconnected, this returns an MST for the source's component only.
+        const id_type s = id_of(source);
+        if (s == npos) return {};
+
+        struct Item { double w; id_type to, from; };
+        auto cmp = [](const Item& a, const Item& b){ return a.w > b.w; };
+        std::priority_queue<Item, std::vector<Item>, decltype(cmp)> pq(cmp);
+        std::vector<char> in_tree(vertex_count(), 0);
+        WeightedEdgeList<T> result;
+
+        pq.push({0.0, s, s}); // dummy
+        while (!pq.empty()) {
+            Item top = pq.top(); pq.pop();
+            if (in_tree[top.to]) continue;
+            in_tree[top.to] = 1;
+            if (top.to != top.from) result.push_back(index_.vertex(top.from), index_.vertex(top.to), top.w);
+
+            for (std::size_t a = arc_begin(top.to); a < arc_end(top.to); ++a)
+                if (!in_tree[targets_[a]]) pq.push({weights_[a], targets_[a], top.to});
+        }
+        return result;
+    }
+
+    // Chu–Liu/Edmonds on dense ids (same contraction scheme as Graph::directed_arborescence_impl)
+    WeightedEdgeList<T> arborescence_(const T& root) const {
+        const int N = static_cast<int>(vertex_count());
+        if (N == 0 || id_of(root) == npos) return {};
+        int root_idx = static_cast<int>(id_of(root));
+
+        struct E { int u, v; double w; };
+        std::vector<E> es; es.reserve(arc_count());
+        for (int u = 0; u < N; ++u)
+            for (std::size_t a = arc_begin(u); a < arc_end(u); ++a)
+                if (static_cast<int>(targets_[a]) != u) es.push_back({u, static_cast<int>(targets_[a]), weights_[a]});
+
+        std::vector<int> pre, idc, vis;
+        std::vector<double> in;
+        int n = N;
+
+        while (true) {
+            in.assign(n, std::numeric_limits<double>::infinity());
+            pre.assign(n, -1);
+            for (auto& e : es) {
+                if (e.u != e.v && e.w < in[e.v]) { in[e.v] = e.w; pre[e.v] = e.u; }
+            }
+            in[root_idx] = 0;
+            for (int i = 0; i < n; i++) {
+                if (i != root_idx && in[i] == std::numeric_limits<double>::infinity()) return {};
+            }
+
+            int cnt = 0;
+            idc.assign(n, -1);
+            vis.assign(n, -1);
+            for (int i = 0; i < n; i++) {
+                int v = i;
+                while (vis[v] != i && idc[v] == -1 && v != root_idx) { vis[v] = i; v = pre[v]; }
+                if (v != root_idx && idc[v] == -1) {
+                    for (int u = pre[v]; u != v; u = pre[u]) idc[u] = cnt;
+                    idc[v] = cnt++;
+                }
+            }
+            if (cnt == 0) {
+                WeightedEdgeList<T> result;
+                result.reserve(n - 1);
+                for (int v = 0; v < n; ++v) {
+                    if (v == root_idx || pre[v] < 0) continue;
+                    const std::size_t a = find_arc(pre[v], v);
+                    result.push_back(index_.vertex(pre[v]), index_.vertex(v), a != arc_count() ? weights_[a] : 0.0);
+                }
+                return result;
+            }
+
+            for (int i = 0; i < n; i++) if (idc[i] == -1) idc[i] = cnt++;
+            std::vector<E> nes; nes.reserve(es.size());
+            for (auto& e : es) {
+                int u = idc[e.u], v = idc[e.v];
+                double w = e.w;
+                if (u != v) w -= in[e.v];
+                nes.push_back({u, v, w});
+            }
+            es.swap(nes);
+            n = cnt;
+            root_idx = idc[root_idx];
+        }
+    }
+
+    std::vector<std::vector<T>> kosaraju_() const {
+        const id_type n = static_cast<id_type>(vertex_count());
+
+        // First pass: iterative DFS with an arc cursor, recording finish order
+        std::vector<char> vis(n, 0);
+        std::vector<id_type> order; order.reserve(n);
+        std::vector<std::pair<id_type, std::size_t>> st;
+        for (id_type s = 0; s < n; ++s) {
+            if (vis[s]) continue;
+            vis[s] = 1; st.push_back({s, arc_begin(s)});
+            while (!st.empty()) {
+                auto& [u, i] = st.back();
+                if (i < arc_end(u)) {
+                    const id_type v = targets_[i++];
+                    if (!vis[v]) { vis[v] = 1; st.push_back({v, arc_begin(v)}); }
+                } else {
+                    order.push_back(u);
+                    st.pop_back();
+                }
+            }
+        }
+
+        // Transposed arcs as a second CSR (counting sort by target)
+        std::vector<std::size_t> toff(n + 1, 0);
+        for (id_type v : targets_) ++toff[v + 1];
+        std::partial_sum(toff.begin(), toff.end(), toff.begin());
+        std::vector<id_type> tsrc(arc_count());
+        std::vector<std::size_t> fill(toff.begin(), toff.end() - 1);
+        for (id_type u = 0; u < n; ++u)
+            for (std::size_t a = arc_begin(u); a < arc_end(u); ++a) tsrc[fill[targets_[a]]++] = u;
+
+        // Second pass on the transpose in reverse finish order
+        std::fill(vis.begin(), vis.end(), 0);
+        std::vector<std::vector<T>> res;
+        std::vector<id_type> stack;
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            if (vis[*it]) continue;
+            std::vector<T> comp;
+            stack.push_back(*it); vis[*it] = 1;
+            while (!stack.empty()) {
+                const id_type u = stack.back(); stack.pop_back();
+                comp.push_back(index_.vertex(u));
+                for (std::size_t a = toff[u]; a < toff[u + 1]; ++a)
+                    if (!vis[tsrc[a]]) { vis[tsrc[a]] = 1; stack.push_back(tsrc[a]); }
+            }
+            res.emplace_back(std::move(comp));
+        }
+        return res;
+    }
+
+    std::vector<std::vector<T>> tarjan_() const {
+        const id_type n = static_cast<id_type>(vertex_count());
+        std::vector<id_type> order(n, npos), low(n, 0), stack;
+        std::vector<char> on_stack(n, 0);
+        std::vector<std::pair<id_type, std::size_t>> st; // (vertex, next arc)
+        std::vector<std::vector<T>> res;
+        id_type counter = 0;
+        auto visit = [&](id_type v){
+            order[v] = low[v] = counter++;
+            stack.push_back(v); on_stack[v] = 1;
+            st.push_back({v, arc_begin(v)});
+        };
+        for (id_type s = 0; s < n; ++s) {
+            if (order[s] != npos) continue;
+            visit(s);
+            while (!st.empty()) {
+                auto& [u, i] = st.back();
+                if (i < arc_end(u)) {
+                    const id_type v = targets_[i++];
+                    if (order[v] == npos) visit(v);
+                    else if (on_stack[v]) low[u] = std::min(low[u], order[v]);
+                    continue;
+                }
+                const id_type v = u;
+                st.pop_back();
+                if (!st.empty()) low[st.back().first] = std::min(low[st.back().first], low[v]);
+                if (low[v] != order[v]) continue;
+                std::vector<T> comp;
+                id_type w;
+                do {
+                    w = stack.back(); stack.pop_back();
+                    on_stack[w] = 0;
+                    comp.push_back(index_.vertex(w));
+                } while (w != v);
+                res.emplace_back(std::move(comp));
+            }
+        }
+        std::reverse(res.begin(), res.end());
+        return res;
+    }
+
+    // Parallel SCC in the style of the Multistep method (Slota, Rajamanickam, Madduri):
+    //   1. trim: a vertex with no live in-arc or no live out-arc inside its part is its own SCC;
+    //   2. forward–backward from the vertex of largest in*out degree: the intersection of its
+    //      forward and backward reachable sets is its SCC (on most real graphs the giant one),
+    //      and the rest splits into three parts that can share no SCC;
+    //   3. until nothing is left: propagate the largest vertex id forward inside each part, then
+    //      every vertex that kept its own id collects its SCC with a backward search restricted
+    //      to its label; the labels become the new parts.
+    // Every phase is a parallel loop over the live vertices on one team of threads; searches are
+    // level-synchronous with atomic claim flags, labels rise with compare-and-swap.
+    std::vector<std::vector<T>> parallel_scc_(std::size_t threads) const {
+        const std::size_t n = vertex_count();
+        if (threads == 0) threads = parallel::thread_count(arc_count());
+        threads = std::max<std::size_t>(1, std::min(threads, n));
+        constexpr auto relaxed = std::memory_order_relaxed;
+        constexpr int trim_passes = 4; // repeated trimming of long chains is left to step 3
+
+        // Transposed arcs, counted and scattered concurrently (row order is irrelevant here)
+        std::vector<std::size_t> toff(n + 1, 0);
+        std::vector<id_type> tsrc(arc_count());
+        {
+            std::vector<std::atomic<std::size_t>> cursor(n);
+            parallel::for_chunks(n, threads, [&](std::size_t b, std::size_t e, std::size_t){
+                for (std::size_t u = b; u < e; ++u)
+                    for (std::size_t a = offsets_[u]; a < offsets_[u + 1]; ++a) cursor[targets_[a]].fetch_add(1, relaxed);
+            });
+            for (std::size_t v = 0; v < n; ++v) {
+                toff[v + 1] = toff[v] + cursor[v].load(relaxed);
+                cursor[v].store(toff[v], relaxed);
+            }
+            parallel::for_chunks(n, threads, [&](std::size_t b, std::size_t e, std::size_t){
+                for (std::size_t u = b; u < e; ++u)
+                    for (std::size_t a = offsets_[u]; a < offsets_[u + 1]; ++a)
+                        tsrc[cursor[targets_[a]].fetch_add(1, relaxed)] = static_cast<id_type>(u);
+            });
+        }
+
+        std::vector<std::atomic<id_type>> comp(n);  // SCC representative, npos while live
+        std::vector<std::atomic<id_type>> label(n); // step 3's propagated maximum
+        std::vector<std::atomic<char>> fwd(n), bwd(n), queued(n);
+        std::vector<id_type> part(n, 0);            // written only between barriers
+        std::vector<id_type> live(n), frontier;
+        std::iota(live.begin(), live.end(), id_type{0});
+        frontier.reserve(n);
+        std::vector<std::vector<id_type>> found(threads);
+        std::vector<std::pair<std::size_t, id_type>> best(threads);
+        std::atomic<bool> removed{false};
+        id_type pivot = 0;
+
+        auto gather = [&](std::vector<id_type>& into){ // worker 0, between barriers
+            into.clear();
+            for (auto& list : found) { into.insert(into.end(), list.begin(), list.end()); list.clear(); }
+        };
+        auto is_live = [&](id_type v){ return comp[v].load(relaxed) == npos; };
+        auto linked = [&](id_type v, const auto& off, const auto& tgt){ // a live arc inside v's part
+            for (std::size_t a = off[v]; a < off[v + 1]; ++a) {
+                const id_type x = tgt[a];
+                if (x != v && part[x] == part[v] && is_live(x)) return true;
+            }
+            return false;
+        };
+
+        parallel::team(threads, [&](std::size_t w, std::size_t workers, parallel::Barrier& sync){
+            auto each = [&](const std::vector<id_type>& list, auto&& f){
+                auto [b, e] = parallel::share(list.size(), w, workers);
+                for (std::size_t i = b; i < e; ++i) f(list[i]);
+            };
+            auto refresh_live = [&]{
+                each(live, [&](id_type v){ if (is_live(v)) found[w].push_back(v); });
+                sync.arrive_and_wait();
+                if (w == 0) gather(live);
+                sync.arrive_and_wait();
+            };
+            auto trim = [&]{
+                for (int pass = 0; pass < trim_passes; ++pass) {
+                    bool mine = false;
+                    each(live, [&](id_type v){
+                        if (!linked(v, offsets_, targets_) || !linked(v, toff, tsrc)) { comp[v].store(v, relaxed); mine = true; }
+                    });
+                    if (mine) removed.store(true, relaxed);
+                    sync.arrive_and_wait();
+                    const bool again = removed.load(relaxed);
+                    sync.arrive_and_wait();
+                    if (w == 0) removed.store(false, relaxed);
+                    refresh_live();
+                    if (!again) break;
+                }
+            };
+            auto reach = [&](const auto& off, const auto& tgt, std::vector<std::atomic<char>>& mark){
+                if (w == 0) { mark[pivot].store(1, relaxed); frontier.assign(1, pivot); }
+                sync.arrive_and_wait();
+                while (!frontier.empty()) {
+                    each(frontier, [&](id_type v){
+                        for (std::size_t a = off[v]; a < off[v + 1]; ++a) {
+                            const id_type x = tgt[a];
+                            if (is_live(x) && !mark[x].exchange(1, relaxed)) found[w].push_back(x);
+                        }
+                    });
+                    sync.arrive_and_wait();
+                    if (w == 0) gather(frontier);
+                    sync.arrive_and_wait();
+                }
+                sync.arrive_and_wait(); // everyone saw the empty frontier before it is reused
+            };
+
+            // 1-2. Trim, then forward–backward from the best-connected vertex
+            each(live, [&](id_type v){ comp[v].store(npos, relaxed); });
+            sync.arrive_and_wait();
+            trim();
+            if (!live.empty()) {
+                best[w] = {0, npos};
+                each(live, [&](id_type v){
+                    const std::size_t score = (toff[v + 1] - toff[v] + 1) * (degree(v) + 1);
+                    if (best[w].second == npos || score > best[w].first) best[w] = {score, v};
+                });
+                sync.arrive_and_wait();
+                if (w == 0) {
+                    auto top = best[0];
+                    for (const auto& b : best) if (b.second != npos && (top.second == npos || b.first > top.first)) top = b;
+                    pivot = top.second;
+                }
+                sync.arrive_and_wait();
+                reach(offsets_, targets_, fwd);
+                reach(toff, tsrc, bwd);
+                each(live, [&](id_type v){
+                    const bool f = fwd[v].load(relaxed), b = bwd[v].load(relaxed);
+                    if (f && b) comp[v].store(pivot, relaxed);
+                    else part[v] = f ? 1 : b ? 2 : 3;
+                });
+                sync.arrive_and_wait();
+                refresh_live();
+                trim();
+            }
+
+            // 3. Label propagation rounds
+            while (!live.empty()) {
+                each(live, [&](id_type v){ label[v].store(v, relaxed); });
+                sync.arrive_and_wait();
+                if (w == 0) frontier = live;
+                sync.arrive_and_wait();
+                while (!frontier.empty()) {
+                    each(frontier, [&](id_type v){
+                        // Clearing the flag and reading the label must not be reordered:
+                        // a raiser that sees queued[v] still set skips the re-queue, so we
+                        // have to read any label it wrote before that exchange. Store-load
+                        // ordering needs a full fence, and the raise side is seq_cst too.
+                        queued[v].store(0, relaxed);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        const id_type lv = label[v].load(relaxed);
+                        for (std::size_t a = offsets_[v]; a < offsets_[v + 1]; ++a) {
+                            const id_type x = targets_[a];
+                            if (part[x] != part[v] || !is_live(x)) continue;
+                            id_type cur = label[x].load(relaxed);
+                            while (cur < lv) {
+                                if (label[x].compare_exchange_weak(cur, lv, std::memory_order_seq_cst,
+                                                                   relaxed)) {
+                                    if (!queued[x].exchange(1, std::memory_order_seq_cst))
+                                        found[w].push_back(x);
+                                    break;
+                                }
+                            }
+                        }
+                    });
+                    sync.arrive_and_wait();
+                    if (w == 0) gather(frontier);
+                    sync.arrive_and_wait();
+                }
+
+                // Roots keep their own id; each collects the vertices of its label that reach it
+                each(live, [&](id_type v){ if (label[v].load(relaxed) == v) found[w].push_back(v); });
+                sync.arrive_and_wait();
+                if (w == 0) gather(frontier);
+                sync.arrive_and_wait();
+                std::vector<id_type> stack;
+                each(frontier, [&](id_type r){
+                    comp[r].store(r, relaxed);
+                    stack.push_back(r);
+                    while (!stack.empty()) {
+                        const id_type u = stack.back(); stack.pop_back();
+                        for (std::size_t a = toff[u]; a < toff[u + 1]; ++a) {
+                            const id_type x = tsrc[a];
+                            if (label[x].load(relaxed) == r && is_live(x)) { comp[x].store(r, relaxed); stack.push_back(x); }
+                        }
+                    }
+                });
+                sync.arrive_and_wait();
+                each(live, [&](id_type v){ if (is_live(v)) part[v] = label[v].load(relaxed); });
+                sync.arrive_and_wait();
+                refresh_live();
+                trim();
+            }
+        });
+
+        // Group by representative, in order of each component's first vertex
+        std::vector<id_type> slot(n, npos);
+        std::vector<std::vector<T>> comps;
+        for (id_type v = 0; v < static_cast<id_type>(n); ++v) {
+            const id_type r = comp[v].load(relaxed);
+            if (slot[r] == npos) { slot[r] = static_cast<id_type>(comps.size()); comps.emplace_back(); }
+            comps[slot[r]].push_back(index_.vertex(v));
+        }
+        return comps;
+    }
+
+    // Components in order of their smallest id, each listed by increasing id
+    std::vector<std::vector<T>> connected_components_(std::size_t threads = 0) const {
+        const std::vector<id_type> label = component_labels(threads);
+        std::vector<id_type> slot(vertex_count(), npos);
+        std::vector<std::vector<T>> comps;
+        for (id_type v = 0; v < static_cast<id_type>(vertex_count()); ++v) {
+            if (slot[label[v]] == npos) { slot[label[v]] = static_cast<id_type>(comps.size()); comps.emplace_back(); }
+            comps[slot[label[v]]].push_back(index_.vertex(v));
+        }
+        return comps;
+    }
+
+    bool dfs_hamilton_(id_type v, id_type start, std::vector<id_type>& path, std::vector<char>& vis) const {
+        if (path.size() == vertex_count()) {
+            if (has_arc(v, start)) { path.push_back(start); return true; }
+            return false;
+        }
+        for (std::size_t a = arc_begin(v); a < arc_end(v); ++a) {
+            const id_type nbr = targets_[a];
+            if (vis[nbr]) continue;
+            vis[nbr] = 1; path.push_back(nbr);
+            if (dfs_hamilton_(nbr, start, path, vis)) return true;
+            path.pop_back(); vis[nbr] = 0;
+        }
+        return false;
+    }
+
+   private:
+    bool directed_{false};
+    bool rows_sorted_{true};                      // targets ascending within each row
+    VertexIndex<T> index_;                        // id <-> original vertex
+    Column<std::size_t> offsets_{std::vector<std::size_t>{0}}; // size n+1
+    Column<id_type> targets_;                     // arc -> target id
+    Column<double> weights_;                      // arc -> weight
+};
+
+}; // namespace Graph_implementation
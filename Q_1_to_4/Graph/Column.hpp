@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstddef>
+
+#include "Memory.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Column<X>: immutable contiguous array of X that either owns a std::vector or borrows
+ * memory it does not own (a mapped snapshot file, see Snapshot.hpp). A borrowed column
+ * holds a shared keep-alive handle, so the mapping lives as long as any column using it.
+ * CSRGraph keeps its offsets/targets/weights in columns so a loaded snapshot is zero-copy.
+ */
+template <typename X>
+class Column{
+   public:
+    Column() = default;
+    Column(std::vector<X> v) : owned_(std::move(v)), data_(owned_.data()), size_(owned_.size()) {}
+    Column(const X* data, std::size_t n, std::shared_ptr<const void> keep_alive)
+        : data_(data), size_(n), keep_(std::move(keep_alive)) {}
+
+    Column(const Column& o) { *this = o; }
+    Column& operator=(const Column& o) {
+        if (this != &o) {
+            owned_ = o.owned_;
+            keep_ = o.keep_;
+            data_ = o.borrowed() ? o.data_ : owned_.data();
+            size_ = o.size_;
+        }
+        return *this;
+    }
+    // A moved vector keeps its buffer, so data_ stays valid
+    Column(Column&& o) noexcept
+        : owned_(std::move(o.owned_)), data_(o.data_), size_(o.size_), keep_(std::move(o.keep_)) {
+        o.data_ = nullptr; o.size_ = 0;
+    }
+    Column& operator=(Column&& o) noexcept {
+        if (this != &o) {
+            owned_ = std::move(o.owned_);
+            data_ = o.data_; size_ = o.size_;
+            keep_ = std::move(o.keep_);
+            o.data_ = nullptr; o.size_ = 0;
+        }
+        return *this;
+    }
+
+    const X& operator[](std::size_t i) const { return data_[i]; }
+    const X* data() const { return data_; }
+    const X* begin() const { return data_; }
+    const X* end() const { return data_ + size_; }
+    const X& back() const { return data_[size_ - 1]; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // True when the elements live in memory owned by someone else (e.g. a file mapping).
+    bool borrowed() const { return static_cast<bool>(keep_); }
+
+    // Borrowed bytes are not heap and are not counted.
+    MemoryUsage memory_usage() const { return memory::of(owned_); }
+
+   private:
+    std::vector<X> owned_;
+    const X* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::shared_ptr<const void> keep_;
+};
+
+}; // namespace Graph_implementation
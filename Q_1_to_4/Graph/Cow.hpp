@@ -0,0 +1,214 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+#include "Storage.hpp"
+#include "VertexIndex.hpp"
+#include "Memory.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Copy-on-write containers behind CowStorage.
+ *
+ * Copying one of these copies a single shared_ptr (O(1)). Data is split in two
+ * levels (a spine of shared chunks / shards, each holding shared rows), and a
+ * write first unshares only the spine, the chunk and the row it touches, so a
+ * snapshot followed by a few edits copies a few chunks instead of the whole graph.
+ *
+ * Writers must own their container (one thread per Graph object, as with the
+ * other storages); readers of older snapshots may run concurrently on other threads.
+ */
+namespace cow_detail{
+
+// Makes *p exclusively owned by the caller, cloning it if another snapshot still shares it.
+template <typename X>
+X& unshare(std::shared_ptr<X>& p) {
+    if (!p) p = std::make_shared<X>();
+    else if (p.use_count() != 1) p = std::make_shared<X>(*p);
+    else std::atomic_thread_fence(std::memory_order_acquire); // last reader is done with it
+    return *p;
+}
+
+inline std::uint64_t mix(std::uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+}; // namespace cow_detail
+
+// Vector of X in shared fixed-size chunks. Non-const operator[] is a write.
+template <typename X, std::size_t ChunkBits = 10>
+class CowVector{
+    static constexpr std::size_t chunk_size = std::size_t{1} << ChunkBits;
+    using chunk = std::vector<X>;
+    using spine = std::vector<std::shared_ptr<chunk>>;
+
+   public:
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    void reserve(std::size_t) {} // chunks never relocate
+    void clear() { spine_.reset(); size_ = 0; } // other snapshots keep their chunks
+
+    const X& operator[](std::size_t i) const { return (*(*spine_)[i >> ChunkBits])[i & (chunk_size - 1)]; }
+    X& operator[](std::size_t i) {
+        spine& s = cow_detail::unshare(spine_);
+        return cow_detail::unshare(s[i >> ChunkBits])[i & (chunk_size - 1)];
+    }
+
+    void push_back(const X& x) {
+        spine& s = cow_detail::unshare(spine_);
+        if ((size_ & (chunk_size - 1)) == 0) {
+            s.push_back(std::make_shared<chunk>());
+            s.back()->reserve(chunk_size);
+        }
+        cow_detail::unshare(s.back()).push_back(x);
+        ++size_;
+    }
+
+    MemoryUsage memory_usage() const { return memory::of(spine_); }
+
+   private:
+    std::shared_ptr<spine> spine_;
+    std::size_t size_ = 0;
+};
+
+// Hash map K -> V split into shards (FlatMap<K, shared_ptr<V>>); shard count doubles
+// as the map grows so each shard stays small. Non-const operator[] is a write;
+// find/at/iteration are read-only on every object, const or not.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class CowMap{
+    using shard = FlatMap<K, std::shared_ptr<V>, Hash>;
+    using spine = std::vector<std::shared_ptr<shard>>;
+    static constexpr std::size_t shard_load = 128;
+
+   public:
+    class const_iterator{
+       public:
+        using value_type = std::pair<const K&, const V&>;
+        struct arrow{
+            value_type p;
+            const value_type* operator->() const { return &p; }
+        };
+
+        const_iterator() = default;
+        const_iterator(const spine* s, std::size_t shard_i, typename shard::const_iterator it)
+            : spine_(s), s_(shard_i), it_(it) { skip_(); }
+
+        value_type operator*() const { return value_type(it_->first, *it_->second); }
+        arrow operator->() const { return arrow{**this}; }
+        const_iterator& operator++() { ++it_; skip_(); return *this; }
+        bool operator==(const const_iterator& o) const { return s_ == o.s_ && (at_end_() || it_ == o.it_); }
+        bool operator!=(const const_iterator& o) const { return !(*this == o); }
+
+       private:
+        bool at_end_() const { return !spine_ || s_ >= spine_->size(); }
+        void skip_() {
+            while (!at_end_() && it_ == shard_(s_).end()) {
+                if (++s_ < spine_->size()) it_ = shard_(s_).begin();
+            }
+        }
+        const shard& shard_(std::size_t i) const { return *(*spine_)[i]; }
+        const spine* spine_ = nullptr;
+        std::size_t s_ = 0;
+        typename shard::const_iterator it_{};
+    };
+    using iterator = const_iterator;
+
+    const_iterator begin() const {
+        if (!spine_ || spine_->empty()) return end();
+        return const_iterator(spine_.get(), 0, std::as_const(*(*spine_)[0]).begin());
+    }
+    const_iterator end() const {
+        return const_iterator(spine_.get(), spine_ ? spine_->size() : 0, {});
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void reserve(std::size_t n) { grow_(n); }
+
+    MemoryUsage memory_usage() const { return memory::of(spine_); }
+
+    const_iterator find(const K& k) const {
+        if (size_ == 0) return end();
+        const std::size_t s = shard_of_(k);
+        const shard& sh = *(*spine_)[s];
+        auto it = sh.find(k);
+        if (it == sh.end()) return end();
+        return const_iterator(spine_.get(), s, it);
+    }
+    std::size_t count(const K& k) const { return find(k) != end() ? 1 : 0; }
+
+    const V& at(const K& k) const {
+        auto it = find(k);
+        if (it == end()) throw std::out_of_range("CowMap::at");
+        return it->second;
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> try_emplace(const K& k, Args&&... args) {
+        auto it = find(k);
+        if (it != end()) return {it, false};
+        grow_(size_ + 1);
+        const std::size_t s = shard_of_(k);
+        spine& sp = cow_detail::unshare(spine_);
+        shard& sh = cow_detail::unshare(sp[s]);
+        sh.try_emplace(k, std::make_shared<V>(std::forward<Args>(args)...));
+        ++size_;
+        return {find(k), true};
+    }
+
+    // Write access: unshares the spine, the key's shard and its value.
+    V& operator[](const K& k) {
+        if (!count(k)) try_emplace(k);
+        spine& sp = cow_detail::unshare(spine_);
+        shard& sh = cow_detail::unshare(sp[shard_of_(k)]);
+        return cow_detail::unshare(sh.find(k)->second);
+    }
+
+   private:
+    std::size_t shard_of_(const K& k) const {
+        return static_cast<std::size_t>(cow_detail::mix(static_cast<std::uint64_t>(Hash{}(k)))) & (spine_->size() - 1);
+    }
+
+    // Keeps ~shard_load keys per shard; a reshard moves the shared values, never copies them.
+    void grow_(std::size_t n) {
+        std::size_t want = spine_ ? spine_->size() : 0;
+        if (want == 0) want = 1;
+        while (want * shard_load < n) want <<= 1;
+        if (spine_ && want == spine_->size()) return;
+
+        auto fresh = std::make_shared<spine>(want);
+        for (auto& sh : *fresh) sh = std::make_shared<shard>();
+        if (spine_) {
+            for (const auto& sh : *spine_)
+                for (const auto& [k, v] : *sh) {
+                    const std::size_t s = static_cast<std::size_t>(cow_detail::mix(static_cast<std::uint64_t>(Hash{}(k)))) & (want - 1);
+                    (*fresh)[s]->try_emplace(k, v);
+                }
+        }
+        spine_ = std::move(fresh);
+    }
+
+    std::shared_ptr<spine> spine_;
+    std::size_t size_ = 0;
+};
+
+// Copy-on-write storage: Graph copies (e.g. the per-commit snapshot in Q_9) are O(1);
+// later edits unshare only the shards, rows and counter chunks they touch.
+struct CowStorage{
+    template <typename T> using row_type = SmallAdjacency<T>;
+    template <typename T, typename Row> using map_type = CowMap<T, Row>;
+    template <typename T> using index_type = VertexIndex<T, CowVector<T>, CowMap<T, std::uint32_t>>;
+    template <typename X> using vector_type = CowVector<X>;
+};
+
+}; // namespace Graph_implementation
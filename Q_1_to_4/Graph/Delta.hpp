@@ -0,0 +1,86 @@
+#pragma once
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+namespace Graph_implementation{
+
+/*
+ * Batched, versioned mutation.
+ * A GraphDelta collects edge deletions and insertions; Graph::apply() performs all of them as
+ * one step: deletions first (so "delete u-v, insert u-v with a new weight" re-weights an edge),
+ * then the insertions in one add_edges() pass. Every effective mutation advances
+ * Graph::version(), a whole delta advances it exactly once, so state derived from the graph can
+ * be stamped with the version it was built at and rebuilt only when the stamp is out of date
+ * (VersionedCache below, used by Graph::snapshot()).
+ */
+template <typename T>
+struct GraphDelta{
+    std::vector<std::tuple<T, T, double>> insertions;
+    std::vector<std::pair<T, T>> deletions; // missing edges are ignored
+
+    GraphDelta& insert(const T& u, const T& v, double w) { insertions.emplace_back(u, v, w); return *this; }
+    GraphDelta& erase(const T& u, const T& v) { deletions.emplace_back(u, v); return *this; }
+
+    bool empty() const { return insertions.empty() && deletions.empty(); }
+    std::size_t size() const { return insertions.size() + deletions.size(); }
+    void clear() { insertions.clear(); deletions.clear(); }
+};
+
+// A value derived from a versioned graph, rebuilt on access when the version moved on.
+// get() is safe to call from several threads. The value is shared (use a const V for data that
+// must not change), so a caller keeps its copy even after a later rebuild. Copies carry the
+// value and its stamp along.
+template <typename V>
+class VersionedCache{
+   public:
+    VersionedCache() = default;
+    VersionedCache(const VersionedCache& other) { std::tie(value_, version_) = other.peek_(); }
+    VersionedCache& operator=(const VersionedCache& other) {
+        if (this != &other) {
+            auto [value, version] = other.peek_();
+            std::lock_guard<std::mutex> lk(mtx_);
+            value_ = std::move(value); version_ = version;
+        }
+        return *this;
+    }
+    VersionedCache(VersionedCache&& other) : VersionedCache(static_cast<const VersionedCache&>(other)) {}
+    VersionedCache& operator=(VersionedCache&& other) { return *this = static_cast<const VersionedCache&>(other); }
+
+    // Value for 'version', calling build() (returning V) only if the cached one is older or absent.
+    template <typename Build>
+    std::shared_ptr<V> get(std::uint64_t version, Build&& build) const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (!value_ || version_ != version) {
+            value_ = std::make_shared<V>(build());
+            version_ = version;
+        }
+        return value_;
+    }
+
+    bool fresh(std::uint64_t version) const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return value_ && version_ == version;
+    }
+
+    void invalidate() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        value_.reset();
+    }
+
+   private:
+    std::pair<std::shared_ptr<V>, std::uint64_t> peek_() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return {value_, version_};
+    }
+
+    mutable std::mutex mtx_;
+    mutable std::shared_ptr<V> value_;
+    mutable std::uint64_t version_ = 0;
+};
+
+}; // namespace Graph_implementation
@@ -0,0 +1,27 @@
+#pragma once
+
+template <typename K> 
+struct Edge {
+    K vertex_w;
+    K vertex_r;
+    double edge_weight = 0.0;
+    double capacity = 0.0;
+    double current_flow = 0.0;
+
+    Edge(K v1, K v2, double w) : vertex_w(v1), vertex_r(v2), edge_weight(w) {}
+    Edge(K v1, K v2, double cap, double flow, int /*tag*/)
+        : vertex_w(v1), vertex_r(v2), capacity(cap), current_flow(flow) {}
+    // helper ctor for residual usage (cap,flow)
+    Edge(K v1, K v2, double cap, double flow) : Edge(v1, v2, cap, flow, 0) {}
+
+    ~Edge() = default;   
+    Edge() = default;      
+
+    void set_current_flow(double value) { current_flow = value; }
+    double residual_capacity() const { return capacity - current_flow; }
+    bool operator>(const Edge& other) const { return edge_weight > other.edge_weight; }
+
+    bool operator==(const Edge<K>& rhs) const {
+        return vertex_w == rhs.vertex_w && vertex_r == rhs.vertex_r;
+    }
+};
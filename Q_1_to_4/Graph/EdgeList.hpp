@@ -0,0 +1,468 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+
+#include "Edge.hpp"
+#include "Memory.hpp"
+#include "Arena.hpp"
+#include "Parallel.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Struct-of-arrays edge containers used by the algorithms instead of vectors of Edge<T>
+ * (Edge<int> carries weight, capacity and flow together: 40 bytes per edge).
+ *
+ * WeightedEdgeList<T>  (from, to, weight) columns: MST / arborescence results
+ * ResidualNetwork      CSR residual graph over dense ids: (to, cap, flow, rev) per arc,
+ *                      with the Edmonds–Karp, Dinic and (parallel) push–relabel max-flow engines
+ */
+
+template <typename T>
+class WeightedEdgeList{
+   public:
+    void reserve(std::size_t n) { from_.reserve(n); to_.reserve(n); weight_.reserve(n); }
+    void push_back(const T& u, const T& v, double w) {
+        from_.push_back(u); to_.push_back(v); weight_.push_back(w);
+    }
+
+    std::size_t size() const { return weight_.size(); }
+    bool empty() const { return weight_.empty(); }
+
+    const T& from(std::size_t i) const { return from_[i]; }
+    const T& to(std::size_t i) const { return to_[i]; }
+    double weight(std::size_t i) const { return weight_[i]; }
+    const std::vector<double>& weights() const { return weight_; }
+
+    double total_weight() const { return std::accumulate(weight_.begin(), weight_.end(), 0.0); }
+
+    Edge<T> operator[](std::size_t i) const { return Edge<T>(from_[i], to_[i], weight_[i]); }
+
+    // Row-wise copy for callers of the Edge<T> API (e.g. Graph::prims_algorithm).
+    std::vector<Edge<T>> to_edges() const {
+        std::vector<Edge<T>> out;
+        out.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i) out.emplace_back(from_[i], to_[i], weight_[i]);
+        return out;
+    }
+
+    MemoryUsage memory_usage() const {
+        MemoryUsage m = memory::of(from_);
+        m += memory::of(to_);
+        m += memory::of(weight_);
+        return m;
+    }
+
+   private:
+    std::vector<T> from_, to_;
+    std::vector<double> weight_;
+};
+
+// Max-flow algorithm run on a ResidualNetwork.
+//   edmonds_karp : BFS augmenting paths, O(VE^2)
+//   dinic        : level graph + blocking flows, O(V^2 E), far fewer BFS passes on layered networks
+//   push_relabel : highest-label push–relabel, O(V^2 sqrt(E)), the fastest on dense networks
+//   parallel_push_relabel : synchronous push–relabel rounds on several threads, for one huge network
+enum class FlowEngine{ edmonds_karp, dinic, push_relabel, parallel_push_relabel };
+
+// "ek"/"edmonds-karp"/"edmonds_karp", "dinic", "pr"/"push-relabel"/"push_relabel" or
+// "ppr"/"parallel-push-relabel"/"parallel_push_relabel" (case-sensitive); throws std::invalid_argument otherwise.
+inline FlowEngine parse_flow_engine(const std::string& name) {
+    if (name == "ek" || name == "edmonds-karp" || name == "edmonds_karp") return FlowEngine::edmonds_karp;
+    if (name == "dinic") return FlowEngine::dinic;
+    if (name == "pr" || name == "push-relabel" || name == "push_relabel") return FlowEngine::push_relabel;
+    if (name == "ppr" || name == "parallel-push-relabel" || name == "parallel_push_relabel") return FlowEngine::parallel_push_relabel;
+    throw std::invalid_argument("unknown max-flow engine '" + name + "'");
+}
+
+// Residual network in CSR form: the arcs leaving u are [offsets[u], offsets[u+1]).
+// Every input arc u->v (capacity c) is paired with a reverse arc v->u of capacity 0;
+// rev[a] is the index of a's partner, so pushing flow is two array writes.
+// The arrays live on the scratch resource current at construction (see Arena.hpp).
+struct ResidualNetwork{
+    using id_type = std::uint32_t;
+    template <typename X> using array = arena::scratch_vector<X>;
+
+    array<std::size_t> offsets{arena::scratch_resource()};
+    array<id_type> to{arena::scratch_resource()};
+    array<double> cap{arena::scratch_resource()};
+    array<double> flow{arena::scratch_resource()};
+    array<std::size_t> rev{arena::scratch_resource()};
+
+    // for_each_arc(f) must call f(u, v, capacity) for every arc of the source graph;
+    // it is invoked twice (count, then fill). If 'forward' is given it receives the residual
+    // index of every input arc, in call order.
+    template <typename ForEachArc>
+    static ResidualNetwork from_arcs(std::size_t n, ForEachArc for_each_arc, std::vector<std::size_t>* forward = nullptr) {
+        ResidualNetwork net;
+        net.offsets.assign(n + 1, 0);
+        for_each_arc([&](id_type u, id_type v, double){ ++net.offsets[u + 1]; ++net.offsets[v + 1]; });
+        std::partial_sum(net.offsets.begin(), net.offsets.end(), net.offsets.begin());
+
+        const std::size_t m = net.offsets.back();
+        net.to.resize(m); net.cap.resize(m); net.flow.assign(m, 0.0); net.rev.resize(m);
+        array<std::size_t> fill(net.offsets.begin(), net.offsets.end() - 1, arena::scratch_resource());
+        if (forward) { forward->clear(); forward->reserve(m / 2); }
+        for_each_arc([&](id_type u, id_type v, double c){
+            const std::size_t f = fill[u]++, b = fill[v]++;
+            if (forward) forward->push_back(f);
+            net.to[f] = v; net.cap[f] = c;   net.rev[f] = b;
+            net.to[b] = u; net.cap[b] = 0.0; net.rev[b] = f;
+        });
+        return net;
+    }
+
+    std::size_t vertex_count() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    std::size_t arc_count() const { return to.size(); }
+    double residual(std::size_t a) const { return cap[a] - flow[a]; }
+    void push(std::size_t a, double f) { flow[a] += f; flow[rev[a]] -= f; }
+    // Back to the zero flow, O(E), keeping the arrays
+    void reset_flow() { std::fill(flow.begin(), flow.end(), 0.0); }
+
+    // Edmonds–Karp: BFS shortest augmenting paths until t is unreachable. Returns the flow value.
+    double edmonds_karp(id_type s, id_type t) {
+        const std::size_t n = vertex_count();
+        if (s >= n || t >= n || s == t) return 0.0;
+        auto parent_arc = arena::scratch_array<std::size_t>(n);
+        auto seen = arena::scratch_array<char>(n);
+        auto q = arena::scratch_array<id_type>(); q.reserve(n);
+        double value = 0.0;
+
+        while (true) {
+            std::fill(seen.begin(), seen.end(), 0);
+            q.clear(); q.push_back(s); seen[s] = 1;
+            bool found = false;
+            for (std::size_t head = 0; head < q.size() && !found; ++head) {
+                const id_type u = q[head];
+                for (std::size_t a = offsets[u]; a < offsets[u + 1]; ++a) {
+                    const id_type v = to[a];
+                    if (residual(a) > 0 && !seen[v]) {
+                        seen[v] = 1; parent_arc[v] = a;
+                        if (v == t) { found = true; break; }
+                        q.push_back(v);
+                    }
+                }
+            }
+            if (!found) break;
+
+            double add = std::numeric_limits<double>::infinity();
+            for (id_type v = t; v != s; v = to[rev[parent_arc[v]]])
+                add = std::min(add, residual(parent_arc[v]));
+            for (id_type v = t; v != s; v = to[rev[parent_arc[v]]])
+                push(parent_arc[v], add);
+            value += add;
+        }
+        return value;
+    }
+
+    // Dinic: BFS levels from s, then blocking flows along level-increasing arcs. The DFS is
+    // iterative (long layered paths do not recurse) and keeps a current-arc pointer per vertex,
+    // so every arc is skipped at most once per phase. Returns the flow value.
+    double dinic(id_type s, id_type t) {
+        const std::size_t n = vertex_count();
+        if (s >= n || t >= n || s == t) return 0.0;
+        constexpr std::uint32_t unreached = std::numeric_limits<std::uint32_t>::max();
+        auto level = arena::scratch_array<std::uint32_t>(n);
+        auto current = arena::scratch_array<std::size_t>(n);
+        auto q = arena::scratch_array<id_type>(); q.reserve(n);
+        auto path = arena::scratch_array<std::size_t>(); // arcs from s to the DFS head
+        double value = 0.0;
+
+        while (true) {
+            // Level graph; stop as soon as t's level is known (deeper vertices cannot reach t in it)
+            std::fill(level.begin(), level.end(), unreached);
+            q.clear(); q.push_back(s); level[s] = 0;
+            for (std::size_t head = 0; head < q.size() && level[t] == unreached; ++head) {
+                const id_type u = q[head];
+                for (std::size_t a = offsets[u]; a < offsets[u + 1]; ++a)
+                    if (residual(a) > 0 && level[to[a]] == unreached) { level[to[a]] = level[u] + 1; q.push_back(to[a]); }
+            }
+            if (level[t] == unreached) break;
+
+            // Blocking flow
+            std::copy(offsets.begin(), offsets.end() - 1, current.begin());
+            path.clear();
+            id_type u = s;
+            while (true) {
+                if (u == t) {
+                    std::size_t bottleneck = 0;
+                    for (std::size_t k = 1; k < path.size(); ++k)
+                        if (residual(path[k]) < residual(path[bottleneck])) bottleneck = k;
+                    const double add = residual(path[bottleneck]);
+                    for (std::size_t a : path) push(a, add);
+                    value += add;
+                    // Resume from the tail of the (now saturated) bottleneck arc, past that arc
+                    path.resize(bottleneck);
+                    u = path.empty() ? s : to[path.back()];
+                    ++current[u];
+                    continue;
+                }
+                std::size_t& a = current[u];
+                while (a < offsets[u + 1] && !(residual(a) > 0 && level[to[a]] == level[u] + 1)) ++a;
+                if (a < offsets[u + 1]) { path.push_back(a); u = to[a]; continue; }
+                // Dead end: drop u from this phase and retreat
+                if (u == s) break;
+                level[u] = unreached;
+                path.pop_back();
+                u = path.empty() ? s : to[path.back()];
+                ++current[u];
+            }
+        }
+        return value;
+    }
+
+    // Highest-label push–relabel with the global-relabel and gap heuristics.
+    // Active vertices wait in per-height buckets and the highest one is discharged first. Heights
+    // are exact distances to t after each global relabel (a reverse BFS over residual arcs), which
+    // is redone once the relabel work since the last one exceeds about 6V + E/2. When a relabel
+    // empties a height (a gap), nothing above it can reach t any more, so those vertices are lifted
+    // out of play. This is phase one only: excess that cannot reach t stays where it is, so the
+    // arrays hold a maximum preflow; its value (the excess at t) and min cut are exact.
+    double push_relabel(id_type s, id_type t) {
+        const std::size_t n = vertex_count();
+        if (s >= n || t >= n || s == t) return 0.0;
+        const std::uint32_t dead = static_cast<std::uint32_t>(n); // height of vertices cut off from t
+        constexpr id_type none = std::numeric_limits<id_type>::max();
+        auto height = arena::scratch_array<std::uint32_t>(n, 0);
+        auto excess = arena::scratch_array<double>(n, 0.0);
+        auto current = arena::scratch_array<std::size_t>(n);
+        auto count = arena::scratch_array<std::size_t>(n + 1, 0);  // vertices per height
+        auto bucket = arena::scratch_array<id_type>(n + 1, none);   // active vertices per height,
+        auto next_active = arena::scratch_array<id_type>(n, none);  // as singly linked lists
+        auto q = arena::scratch_array<id_type>(); q.reserve(n);
+        std::size_t top = 0; // no active vertex is higher
+
+        auto activate = [&](id_type v){
+            next_active[v] = bucket[height[v]]; bucket[height[v]] = v;
+            top = std::max<std::size_t>(top, height[v]);
+        };
+        auto global_relabel = [&]{
+            std::fill(height.begin(), height.end(), dead);
+            std::fill(count.begin(), count.end(), 0);
+            std::fill(bucket.begin(), bucket.end(), none);
+            height[t] = 0; q.clear(); q.push_back(t);
+            for (std::size_t head = 0; head < q.size(); ++head) {
+                const id_type v = q[head];
+                ++count[height[v]];
+                for (std::size_t b = offsets[v]; b < offsets[v + 1]; ++b) {
+                    const id_type w = to[b]; // rev[b] is the arc w->v
+                    if (w != s && height[w] == dead && residual(rev[b]) > 0) { height[w] = height[v] + 1; q.push_back(w); }
+                }
+            }
+            top = 0;
+            for (id_type v = 0; v < n; ++v) {
+                current[v] = offsets[v];
+                if (v != s && v != t && excess[v] > 0 && height[v] < dead) activate(v);
+            }
+        };
+
+        for (std::size_t a = offsets[s]; a < offsets[s + 1]; ++a) {
+            const double d = residual(a);
+            if (d > 0) { push(a, d); excess[to[a]] += d; excess[s] -= d; }
+        }
+        global_relabel();
+
+        const std::size_t relabel_budget = 6 * n + arc_count() / 2;
+        std::size_t work = 0;
+        while (true) {
+            while (top > 0 && bucket[top] == none) --top;
+            const id_type u = bucket[top];
+            if (u == none) break;
+            bucket[top] = next_active[u];
+            if (height[u] != top) continue; // lifted by a gap while waiting
+
+            // Discharge u: push along admissible arcs, relabel when they run out
+            while (excess[u] > 0) {
+                if (current[u] == offsets[u + 1]) {
+                    const std::uint32_t old = height[u];
+                    std::uint32_t h = dead;
+                    for (std::size_t a = offsets[u]; a < offsets[u + 1]; ++a)
+                        if (residual(a) > 0) h = std::min(h, height[to[a]] + 1);
+                    work += offsets[u + 1] - offsets[u] + 12;
+                    if (--count[old] == 0) {
+                        for (std::uint32_t& hv : height)
+                            if (hv > old && hv < dead) { --count[hv]; hv = dead; }
+                        height[u] = dead;
+                        break;
+                    }
+                    if (h >= dead) { height[u] = dead; break; }
+                    height[u] = h; ++count[h]; current[u] = offsets[u];
+                    continue;
+                }
+                const std::size_t a = current[u];
+                const id_type v = to[a];
+                if (residual(a) > 0 && height[u] == height[v] + 1) {
+                    const double d = std::min(excess[u], residual(a));
+                    const bool was_idle = excess[v] <= 0;
+                    push(a, d); excess[u] -= d; excess[v] += d;
+                    if (was_idle && v != t && v != s) activate(v);
+                } else {
+                    ++current[u];
+                }
+            }
+            if (work > relabel_budget) { global_relabel(); work = 0; }
+        }
+        return excess[t];
+    }
+
+    // Push–relabel in synchronous rounds on 'threads' threads (0 = all hardware threads).
+    // In a round every active vertex pushes along admissible arcs judged by the heights of the
+    // previous round, then the vertices still holding excess relabel from those same heights
+    // (Goldberg–Tarjan's synchronous variant). With heights frozen, two threads never touch the
+    // same arc pair (u pushes to v only if h[u] = h[v] + 1), so the only shared writes are excess
+    // increments, made with atomic adds into 'incoming' and folded in between rounds. Global
+    // relabels, a level-synchronous parallel BFS from t, run first and whenever the relabels
+    // since the last one exceed V/2. Like push_relabel this leaves a maximum preflow.
+    double parallel_push_relabel(id_type s, id_type t, std::size_t threads = 0) {
+        const std::size_t n = vertex_count();
+        if (s >= n || t >= n || s == t) return 0.0;
+        if (threads == 0) threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        threads = std::min(threads, n);
+        const std::uint32_t dead = static_cast<std::uint32_t>(n);
+        constexpr auto relaxed = std::memory_order_relaxed;
+
+        arena::scratch_vector<std::atomic<std::uint32_t>> height(n, arena::scratch_resource());
+        arena::scratch_vector<std::atomic<double>> incoming(n, arena::scratch_resource()); // pushed in this round
+        arena::scratch_vector<std::atomic<char>> queued(n, arena::scratch_resource());     // listed for the next round
+        auto excess = arena::scratch_array<double>(n, 0.0);
+        auto relabeled = arena::scratch_array<std::uint32_t>(n, 0);
+        auto active = arena::scratch_array<id_type>(); active.reserve(n);   // only worker 0 writes these two,
+        auto frontier = arena::scratch_array<id_type>(); frontier.reserve(n); // within the reserved capacity
+        // Lists filled inside the workers live on the heap: the scratch resource may be a single-threaded arena
+        std::vector<std::vector<id_type>> found(threads), relabel(threads);
+        std::atomic<std::size_t> relabels{0};
+        bool global = true;
+        const std::size_t global_after = n / 2 + 1;
+
+        auto add = [](std::atomic<double>& x, double d){
+            double cur = x.load(relaxed);
+            while (!x.compare_exchange_weak(cur, cur + d, relaxed)) {}
+        };
+        auto gather = [&](auto& into){ // worker 0, between barriers
+            into.clear();
+            for (auto& list : found) { into.insert(into.end(), list.begin(), list.end()); list.clear(); }
+        };
+
+        for (std::size_t a = offsets[s]; a < offsets[s + 1]; ++a) {
+            const double d = residual(a);
+            if (d > 0 && to[a] != s) { push(a, d); excess[to[a]] += d; }
+        }
+        incoming[t].store(excess[t], relaxed); // t's inflow is counted in 'incoming' only
+        excess[t] = 0.0;
+
+        parallel::team(threads, [&](std::size_t w, std::size_t workers, parallel::Barrier& sync){
+            auto global_relabel = [&]{
+                auto [vb, ve] = parallel::share(n, w, workers);
+                for (std::size_t v = vb; v < ve; ++v) height[v].store(dead, relaxed);
+                sync.arrive_and_wait();
+                if (w == 0) { height[t].store(0, relaxed); frontier.assign(1, t); }
+                sync.arrive_and_wait();
+                for (std::uint32_t level = 1; !frontier.empty(); ++level) {
+                    auto [fb, fe] = parallel::share(frontier.size(), w, workers);
+                    for (std::size_t i = fb; i < fe; ++i) {
+                        const id_type v = frontier[i];
+                        for (std::size_t b = offsets[v]; b < offsets[v + 1]; ++b) {
+                            const id_type x = to[b]; // rev[b] is the arc x->v
+                            std::uint32_t expected = dead;
+                            if (x != s && residual(rev[b]) > 0 && height[x].load(relaxed) == dead
+                                && height[x].compare_exchange_strong(expected, level, relaxed))
+                                found[w].push_back(x);
+                        }
+                    }
+                    sync.arrive_and_wait();
+                    if (w == 0) gather(frontier);
+                    sync.arrive_and_wait();
+                }
+                for (std::size_t v = vb; v < ve; ++v)
+                    if (v != s && v != t && excess[v] > 0 && height[v].load(relaxed) < dead) found[w].push_back(static_cast<id_type>(v));
+                sync.arrive_and_wait();
+                if (w == 0) { gather(active); relabels.store(0, relaxed); global = false; }
+                sync.arrive_and_wait();
+            };
+
+            while (true) {
+                if (global) global_relabel();
+                if (active.empty()) break;
+
+                // Push against the frozen heights
+                auto [ab, ae] = parallel::share(active.size(), w, workers);
+                for (std::size_t i = ab; i < ae; ++i) {
+                    const id_type v = active[i];
+                    const std::uint32_t hv = height[v].load(relaxed);
+                    double e = excess[v];
+                    for (std::size_t a = offsets[v]; a < offsets[v + 1] && e > 0; ++a) {
+                        const id_type x = to[a];
+                        if (height[x].load(relaxed) + 1 != hv) continue; // before residual(a): x never pushes back to v this round
+                        const double r = residual(a);
+                        if (r <= 0) continue;
+                        const double d = std::min(e, r);
+                        push(a, d); e -= d;
+                        add(incoming[x], d);
+                        if (x != t && !queued[x].exchange(1, relaxed)) found[w].push_back(x);
+                    }
+                    excess[v] = e;
+                    if (e > 0) relabel[w].push_back(v);
+                }
+                sync.arrive_and_wait();
+
+                // Relabel from the same heights
+                for (const id_type v : relabel[w]) {
+                    std::uint32_t h = dead;
+                    for (std::size_t a = offsets[v]; a < offsets[v + 1]; ++a)
+                        if (residual(a) > 0) h = std::min(h, height[to[a]].load(relaxed) + 1);
+                    relabeled[v] = h;
+                }
+                relabels.fetch_add(relabel[w].size(), relaxed);
+                sync.arrive_and_wait();
+                for (const id_type v : relabel[w]) {
+                    height[v].store(relabeled[v], relaxed);
+                    if (relabeled[v] < dead && !queued[v].exchange(1, relaxed)) found[w].push_back(v);
+                }
+                relabel[w].clear();
+                sync.arrive_and_wait();
+
+                // Fold the pushes in; every listed vertex is in exactly one worker's list
+                auto& mine = found[w];
+                std::size_t keep = 0;
+                for (const id_type v : mine) {
+                    queued[v].store(0, relaxed);
+                    excess[v] += incoming[v].exchange(0.0, relaxed);
+                    if (excess[v] > 0 && height[v].load(relaxed) < dead) mine[keep++] = v;
+                }
+                mine.resize(keep);
+                sync.arrive_and_wait();
+                if (w == 0) { gather(active); global = relabels.load(relaxed) >= global_after; }
+                sync.arrive_and_wait();
+            }
+        });
+        return incoming[t].load(relaxed);
+    }
+
+    double max_flow(id_type s, id_type t, FlowEngine engine, std::size_t threads = 0) {
+        switch (engine) {
+            case FlowEngine::dinic:                 return dinic(s, t);
+            case FlowEngine::push_relabel:          return push_relabel(s, t);
+            case FlowEngine::parallel_push_relabel: return parallel_push_relabel(s, t, threads);
+            default:                                return edmonds_karp(s, t);
+        }
+    }
+
+    MemoryUsage memory_usage() const {
+        MemoryUsage m = memory::of(offsets);
+        m += memory::of(to);
+        m += memory::of(cap);
+        m += memory::of(flow);
+        m += memory::of(rev);
+        return m;
+    }
+};
+
+}; // namespace Graph_implementation
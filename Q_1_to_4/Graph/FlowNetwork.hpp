@@ -0,0 +1,119 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+
+#include "CSRGraph.hpp"
+#include "EdgeList.hpp"
+#include "Arena.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Reusable max-flow state for one graph version.
+ * The residual network is built once from a CSR snapshot and then serves any number of
+ * (source, sink) queries:
+ *   - a query for a new pair resets the flows in O(E) (no reallocation) and solves from zero;
+ *   - repeating the last pair reuses its maximum flow and only augments what is new, so after
+ *     set_capacity() raised a few capacities the answer costs a few augmenting paths.
+ * Lowering a capacity below the flow it carries discards the warm flow (the next query starts
+ * over). The push–relabel engines leave a preflow rather than a flow, so they never warm-start the
+ * next query.
+ *
+ * Queries are serialized by an internal mutex, so one network can be shared between threads
+ * (Graph::flow_network() hands the same one to every copy of an unchanged graph). Its arrays
+ * always live on the global heap, never in a job arena, because the network outlives the job.
+ */
+template <typename T>
+class FlowNetwork{
+   public:
+    using id_type = typename CSRGraph<T>::id_type;
+
+    explicit FlowNetwork(std::shared_ptr<const CSRGraph<T>> graph)
+        : graph_(std::move(graph)), net_(on_heap_(*graph_, forward_)) {}
+
+    FlowNetwork(FlowNetwork&& other) noexcept
+        : graph_(std::move(other.graph_)), forward_(std::move(other.forward_)), net_(std::move(other.net_)),
+          warm_(other.warm_), s_(other.s_), t_(other.t_), value_(other.value_) {}
+
+    // Max-flow value from 'source' to 'sink' (0 if either is unknown or they coincide).
+    // 'threads' is used by parallel_push_relabel only (0 = all hardware threads).
+    double max_flow(const T& source, const T& sink, FlowEngine engine = FlowEngine::edmonds_karp,
+                    std::size_t threads = 0) {
+        const id_type s = graph_->id_of(source), t = graph_->id_of(sink);
+        if (s == CSRGraph<T>::npos || t == CSRGraph<T>::npos || s == t) return 0.0;
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (!(warm_ && s_ == s && t_ == t)) {
+            net_.reset_flow();
+            value_ = 0.0;
+        }
+        value_ += net_.max_flow(s, t, engine, threads);
+        warm_ = engine == FlowEngine::edmonds_karp || engine == FlowEngine::dinic;
+        s_ = s; t_ = t;
+        return value_;
+    }
+
+    // Sets the capacity of u->v (both directions for an undirected graph). Returns false if the
+    // snapshot has no such edge: edges cannot be added, a new graph version needs a new network.
+    bool set_capacity(const T& u, const T& v, double capacity) {
+        const id_type iu = graph_->id_of(u), iv = graph_->id_of(v);
+        if (iu == CSRGraph<T>::npos || iv == CSRGraph<T>::npos) return false;
+        const std::size_t a = graph_->find_arc(iu, iv);
+        if (a == graph_->arc_count()) return false;
+        std::lock_guard<std::mutex> lk(mtx_);
+        set_arc_(forward_[a], capacity);
+        if (!graph_->is_directed()) {
+            const std::size_t b = graph_->find_arc(iv, iu);
+            if (b != graph_->arc_count()) set_arc_(forward_[b], capacity);
+        }
+        return true;
+    }
+
+    // Back to the zero flow (O(E)); the next query solves from scratch.
+    void reset() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        net_.reset_flow();
+        warm_ = false;
+        value_ = 0.0;
+    }
+
+    // Capacity / current flow of u->v as of the last query (0 if there is no such edge).
+    double capacity(const T& u, const T& v) const { return arc_value_(u, v, &ResidualNetwork::cap); }
+    double flow(const T& u, const T& v) const { return arc_value_(u, v, &ResidualNetwork::flow); }
+
+    const CSRGraph<T>& graph() const { return *graph_; }
+    const ResidualNetwork& residual() const { return net_; }
+
+   private:
+    static ResidualNetwork on_heap_(const CSRGraph<T>& graph, std::vector<std::size_t>& forward) {
+        arena::ScratchScope heap(nullptr);
+        return graph.residual_network(&forward);
+    }
+
+    void set_arc_(std::size_t a, double capacity) {
+        if (capacity < net_.flow[a]) warm_ = false; // the stored flow no longer fits
+        net_.cap[a] = capacity;
+    }
+
+    template <typename Column>
+    double arc_value_(const T& u, const T& v, Column column) const {
+        const id_type iu = graph_->id_of(u), iv = graph_->id_of(v);
+        if (iu == CSRGraph<T>::npos || iv == CSRGraph<T>::npos) return 0.0;
+        const std::size_t a = graph_->find_arc(iu, iv);
+        if (a == graph_->arc_count()) return 0.0;
+        std::lock_guard<std::mutex> lk(mtx_);
+        return (net_.*column)[forward_[a]];
+    }
+
+    std::shared_ptr<const CSRGraph<T>> graph_;
+    std::vector<std::size_t> forward_; // snapshot arc -> residual arc
+    ResidualNetwork net_;
+    mutable std::mutex mtx_;
+    bool warm_ = false;                // net_ holds a maximum s_ -> t_ flow
+    id_type s_ = 0, t_ = 0;
+    double value_ = 0.0;
+};
+
+}; // namespace Graph_implementation
@@ -0,0 +1,328 @@
+#pragma once
+#include <vector>
+#include <tuple>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "Parallel.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Seeded random graph generators. Each returns an edge list of (u, v, weight) tuples over the
+ * vertex labels 0..n-1, ready for Graph::add_edges() or CSRGraph::from_edges().
+ * No self-loops and no repeated pairs; an undirected pair is emitted once as (u, v) with u < v.
+ *
+ * Uniform models: gnp, gnm. Skewed / structured models for benchmarks: rmat (power-law hubs),
+ * barabasi_albert (preferential attachment), grid (road-like lattice), layered_flow (s-t network).
+ *
+ * Random draws are cut into fixed blocks, each with its own RNG stream derived from (seed, block).
+ * Blocks run on parallel::for_chunks workers and are concatenated in order, so the output
+ * depends only on the arguments, never on the thread count.
+ */
+namespace generators{
+
+using rng_type = std::mt19937_64;
+
+// Weight samplers: any callable double(rng_type&) can be passed instead.
+struct constant_weight{
+    double w = 1.0;
+    double operator()(rng_type&) const { return w; }
+};
+struct uniform_weight{
+    double lo = 1.0, hi = 10.0;
+    double operator()(rng_type& rng) const { return std::uniform_real_distribution<double>(lo, hi)(rng); }
+};
+struct uniform_int_weight{
+    long lo = 1, hi = 10;
+    double operator()(rng_type& rng) const { return static_cast<double>(std::uniform_int_distribution<long>(lo, hi)(rng)); }
+};
+struct exponential_weight{
+    double mean = 5.0;
+    double operator()(rng_type& rng) const { return std::exponential_distribution<double>(1.0 / mean)(rng); }
+};
+// Pareto: lo * U^(-1/alpha); few heavy edges, many light ones
+struct pareto_weight{
+    double lo = 1.0, alpha = 2.0;
+    double operator()(rng_type& rng) const {
+        return lo * std::pow(1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(rng), -1.0 / alpha);
+    }
+};
+
+namespace detail{
+
+// splitmix64 finaliser: decorrelates the per-block seeds
+inline std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline rng_type stream(std::uint64_t seed, std::uint64_t block) { return rng_type(mix(seed ^ mix(block))); }
+
+// Pair numbering: directed rows hold the n-1 targets j != i, undirected rows the j > i.
+struct PairSpace{
+    std::uint64_t n;
+    bool directed;
+
+    std::uint64_t size() const { return directed ? n * (n - 1) : n * (n - 1) / 2; }
+    std::uint64_t row_begin(std::uint64_t i) const { return directed ? i * (n - 1) : i * n - i * (i + 1) / 2; }
+
+    std::pair<std::uint64_t, std::uint64_t> pair(std::uint64_t idx) const {
+        if (directed) {
+            const std::uint64_t i = idx / (n - 1), k = idx % (n - 1);
+            return {i, k < i ? k : k + 1};
+        }
+        // Last row whose start is <= idx (row n-1 is empty and starts at size())
+        std::uint64_t lo = 0, hi = n - 1;
+        while (lo + 1 < hi) {
+            const std::uint64_t mid = lo + (hi - lo) / 2;
+            (row_begin(mid) <= idx ? lo : hi) = mid;
+        }
+        return {lo, lo + 1 + (idx - row_begin(lo))};
+    }
+};
+
+// Fixed block length for a space of N pairs (independent of the machine)
+inline std::uint64_t block_length(std::uint64_t N) {
+    return std::max<std::uint64_t>(std::uint64_t{1} << 20, (N + 1023) / 1024);
+}
+
+// Runs gen(block, first, last, out) per block on the worker pool and concatenates the outputs.
+template <typename T, typename Gen>
+std::vector<std::tuple<T, T, double>> run_blocks(std::uint64_t N, std::uint64_t len, std::size_t expected, Gen gen) {
+    const std::size_t blocks = static_cast<std::size_t>((N + len - 1) / len);
+    std::vector<std::vector<std::tuple<T, T, double>>> parts(blocks);
+    parallel::for_chunks(blocks, parallel::thread_count(expected), [&](std::size_t b, std::size_t e, std::size_t){
+        for (std::size_t k = b; k < e; ++k)
+            gen(static_cast<std::uint64_t>(k), k * len, std::min(N, (k + 1) * len), parts[k]);
+    });
+    std::vector<std::tuple<T, T, double>> out;
+    std::size_t total = 0;
+    for (const auto& p : parts) total += p.size();
+    out.reserve(total);
+    for (auto& p : parts) out.insert(out.end(), p.begin(), p.end());
+    return out;
+}
+
+}; // namespace detail
+
+// Erdős–Rényi G(n, p): every candidate pair independently with probability p.
+// Geometric skips jump straight to the next chosen pair, so the cost is O(n + m), not O(n²).
+template <typename T = int, typename Weight = constant_weight>
+std::vector<std::tuple<T, T, double>> gnp(std::size_t n, double p, bool directed, std::uint64_t seed, Weight weight = {}) {
+    const detail::PairSpace space{n, directed};
+    if (n < 2 || !(p > 0.0)) return {};
+    const std::uint64_t N = space.size();
+    const double log_q = std::log1p(-std::min(p, 1.0)); // -inf when p >= 1: every pair
+    const std::size_t expected = static_cast<std::size_t>(std::min<double>(static_cast<double>(N), p * static_cast<double>(N)));
+
+    return detail::run_blocks<T>(N, detail::block_length(N), expected,
+        [&](std::uint64_t block, std::uint64_t first, std::uint64_t last, std::vector<std::tuple<T, T, double>>& out){
+            rng_type rng = detail::stream(seed, block);
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            out.reserve(static_cast<std::size_t>(p * static_cast<double>(last - first) * 1.1) + 16);
+            for (std::uint64_t idx = first;; ++idx) {
+                // Number of rejected pairs before the next hit ~ Geometric(p)
+                const double skip = std::floor(std::log1p(-unit(rng)) / log_q);
+                if (!(skip < static_cast<double>(last - idx))) break; // also catches NaN
+                idx += static_cast<std::uint64_t>(skip);
+                const auto [u, v] = space.pair(idx);
+                out.emplace_back(static_cast<T>(u), static_cast<T>(v), weight(rng));
+            }
+        });
+}
+
+// G(n, m): exactly m distinct pairs chosen uniformly (fewer if m exceeds the number of pairs).
+// Pair ids are drawn in batches, sorted and deduplicated until m are distinct (no hash set);
+// a dense request samples the complement instead. Edges come out in pair order.
+template <typename T = int, typename Weight = constant_weight>
+std::vector<std::tuple<T, T, double>> gnm(std::size_t n, std::size_t m, bool directed, std::uint64_t seed, Weight weight = {}) {
+    const detail::PairSpace space{n, directed};
+    if (n < 2 || m == 0) return {};
+    const std::uint64_t N = space.size();
+    const bool complement = m > N / 2;
+    const std::uint64_t want = complement ? N - std::min<std::uint64_t>(m, N) : m;
+
+    // Draws come in fixed blocks with their own streams, so the ids do not depend on the thread count
+    constexpr std::size_t draw_block = std::size_t{1} << 16;
+    std::vector<std::uint64_t> picked;
+    for (std::uint64_t round = 0; picked.size() < want; ++round) {
+        const std::size_t missing = static_cast<std::size_t>(want - picked.size());
+        const std::size_t blocks = (missing + draw_block - 1) / draw_block;
+        const std::size_t old = picked.size();
+        picked.resize(old + missing);
+        parallel::for_chunks(blocks, parallel::thread_count(missing), [&](std::size_t b, std::size_t e, std::size_t){
+            for (std::size_t k = b; k < e; ++k) {
+                rng_type rng = detail::stream(seed, (round << 32) + k);
+                std::uniform_int_distribution<std::uint64_t> any(0, N - 1);
+                for (std::size_t i = k * draw_block; i < std::min(missing, (k + 1) * draw_block); ++i)
+                    picked[old + i] = any(rng);
+            }
+        });
+        std::sort(picked.begin() + old, picked.end());
+        std::inplace_merge(picked.begin(), picked.begin() + old, picked.end());
+        picked.erase(std::unique(picked.begin(), picked.end()), picked.end());
+    }
+
+    // Walk the chosen ids (or the gaps between them) in order, emitting edges by block
+    return detail::run_blocks<T>(N, detail::block_length(N), static_cast<std::size_t>(std::min<std::uint64_t>(m, N)),
+        [&](std::uint64_t block, std::uint64_t first, std::uint64_t last, std::vector<std::tuple<T, T, double>>& out){
+            rng_type rng = detail::stream(seed ^ 0x5bd1e995ULL, block);
+            auto it = std::lower_bound(picked.begin(), picked.end(), first);
+            auto emit = [&](std::uint64_t idx){
+                const auto [u, v] = space.pair(idx);
+                out.emplace_back(static_cast<T>(u), static_cast<T>(v), weight(rng));
+            };
+            if (!complement) {
+                for (; it != picked.end() && *it < last; ++it) emit(*it);
+                return;
+            }
+            for (std::uint64_t idx = first; idx < last; ++idx) {
+                if (it != picked.end() && *it == idx) { ++it; continue; }
+                emit(idx);
+            }
+        });
+}
+
+// R-MAT (Kronecker-style) graph on 2^scale vertices: each of the m draws descends 'scale' levels,
+// picking the quadrant a / b / c / 1-a-b-c of the adjacency matrix. a > d skews degrees towards
+// low ids (the Graph500 defaults give a few hubs and a long tail). Self-loops and repeated pairs
+// are dropped, so fewer than m edges may come back; output is sorted by (u, v).
+struct RmatParams{ double a = 0.57, b = 0.19, c = 0.19; };
+
+template <typename T = int, typename Weight = constant_weight>
+std::vector<std::tuple<T, T, double>> rmat(unsigned scale, std::size_t m, bool directed, std::uint64_t seed,
+                                           Weight weight = {}, RmatParams q = {}) {
+    using edge = std::tuple<T, T, double>;
+    if (scale == 0 || m == 0) return {};
+    constexpr std::size_t draw_block = std::size_t{1} << 16;
+    const std::size_t blocks = (m + draw_block - 1) / draw_block;
+    std::vector<edge> out(m);
+    std::vector<char> keep(m, 0);
+    parallel::for_chunks(blocks, parallel::thread_count(m), [&](std::size_t b, std::size_t e, std::size_t){
+        for (std::size_t k = b; k < e; ++k) {
+            rng_type rng = detail::stream(seed, k);
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            for (std::size_t i = k * draw_block; i < std::min(m, (k + 1) * draw_block); ++i) {
+                std::uint64_t u = 0, v = 0;
+                for (unsigned level = 0; level < scale; ++level) {
+                    const double r = unit(rng);
+                    const bool down = r >= q.a + q.b, right = (r >= q.a && r < q.a + q.b) || r >= q.a + q.b + q.c;
+                    u = (u << 1) | down;
+                    v = (v << 1) | right;
+                }
+                if (!directed && u > v) std::swap(u, v);
+                out[i] = edge(static_cast<T>(u), static_cast<T>(v), weight(rng));
+                keep[i] = u != v;
+            }
+        }
+    });
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < m; ++i) if (keep[i]) out[kept++] = out[i];
+    out.resize(kept);
+    // Full-tuple order, so the surviving weight of a repeated pair is the same on any thread count
+    parallel::sort(out, [](const edge& x, const edge& y){ return x < y; });
+    out.erase(std::unique(out.begin(), out.end(), [](const edge& x, const edge& y){
+        return std::get<0>(x) == std::get<0>(y) && std::get<1>(x) == std::get<1>(y);
+    }), out.end());
+    return out;
+}
+
+// Barabási–Albert preferential attachment (undirected): a clique on k+1 seed vertices, then each
+// new vertex links to k distinct earlier vertices chosen with probability proportional to degree.
+// Yields k(k+1)/2 + (n-k-1)k edges and power-law degrees. Inherently sequential (each step reads
+// the degrees so far); O(n k) with the endpoint-list trick.
+template <typename T = int, typename Weight = constant_weight>
+std::vector<std::tuple<T, T, double>> barabasi_albert(std::size_t n, std::size_t k, std::uint64_t seed, Weight weight = {}) {
+    std::vector<std::tuple<T, T, double>> out;
+    if (k == 0 || n < 2) return out;
+    k = std::min(k, n - 1);
+    rng_type rng = detail::stream(seed, 0);
+    out.reserve(k * (k + 1) / 2 + (n - k - 1) * k);
+    std::vector<std::uint64_t> ends; // every edge endpoint once: uniform pick = degree-proportional pick
+    ends.reserve(2 * out.capacity());
+    for (std::uint64_t u = 0; u <= k; ++u)
+        for (std::uint64_t v = u + 1; v <= k; ++v) {
+            out.emplace_back(static_cast<T>(u), static_cast<T>(v), weight(rng));
+            ends.push_back(u); ends.push_back(v);
+        }
+    std::vector<std::uint64_t> chosen;
+    for (std::uint64_t v = k + 1; v < n; ++v) {
+        chosen.clear();
+        std::uniform_int_distribution<std::size_t> pick(0, ends.size() - 1);
+        while (chosen.size() < k) {
+            const std::uint64_t u = ends[pick(rng)];
+            if (std::find(chosen.begin(), chosen.end(), u) == chosen.end()) chosen.push_back(u);
+        }
+        std::sort(chosen.begin(), chosen.end());
+        for (std::uint64_t u : chosen) {
+            out.emplace_back(static_cast<T>(u), static_cast<T>(v), weight(rng));
+            ends.push_back(u); ends.push_back(v);
+        }
+    }
+    return out;
+}
+
+// Road-like lattice: rows x cols vertices (id = r * cols + c), each 4-neighbour edge kept with
+// probability 'keep' (1.0 = full grid). Low, even degrees and a large diameter, the opposite of rmat.
+template <typename T = int, typename Weight = constant_weight>
+std::vector<std::tuple<T, T, double>> grid(std::size_t rows, std::size_t cols, std::uint64_t seed,
+                                           Weight weight = {}, double keep = 1.0) {
+    using edge = std::tuple<T, T, double>;
+    std::vector<std::vector<edge>> parts(rows);
+    parallel::for_chunks(rows, parallel::thread_count(rows * cols), [&](std::size_t b, std::size_t e, std::size_t){
+        for (std::size_t r = b; r < e; ++r) {
+            rng_type rng = detail::stream(seed, r);
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+            auto link = [&](std::size_t u, std::size_t v){
+                if (keep >= 1.0 || unit(rng) < keep) parts[r].emplace_back(static_cast<T>(u), static_cast<T>(v), weight(rng));
+            };
+            for (std::size_t c = 0; c < cols; ++c) {
+                const std::size_t u = r * cols + c;
+                if (c + 1 < cols) link(u, u + 1);
+                if (r + 1 < rows) link(u, u + cols);
+            }
+        }
+    });
+    std::vector<edge> out;
+    for (auto& p : parts) out.insert(out.end(), p.begin(), p.end());
+    return out;
+}
+
+// Directed s-t network: source 0 -> every vertex of layer 0, each layer vertex -> 'fanout'
+// distinct random vertices of the next layer, last layer -> sink. Layer d vertex i has id
+// 1 + d * width + i; the sink is 1 + layers * width. Weights are the capacities.
+template <typename T = int, typename Weight = constant_weight>
+std::vector<std::tuple<T, T, double>> layered_flow(std::size_t layers, std::size_t width, std::size_t fanout,
+                                                   std::uint64_t seed, Weight weight = {}) {
+    std::vector<std::tuple<T, T, double>> out;
+    if (layers == 0 || width == 0) return out;
+    fanout = std::min(fanout, width);
+    const std::uint64_t sink = 1 + layers * width;
+    rng_type rng = detail::stream(seed, 0);
+    std::uniform_int_distribution<std::size_t> any(0, width - 1);
+    for (std::uint64_t i = 0; i < width; ++i) out.emplace_back(T(0), static_cast<T>(1 + i), weight(rng));
+    std::vector<std::size_t> next;
+    for (std::uint64_t d = 0; d + 1 < layers; ++d)
+        for (std::uint64_t i = 0; i < width; ++i) {
+            next.clear();
+            while (next.size() < fanout) {
+                const std::size_t j = any(rng);
+                if (std::find(next.begin(), next.end(), j) == next.end()) next.push_back(j);
+            }
+            for (std::size_t j : next)
+                out.emplace_back(static_cast<T>(1 + d * width + i), static_cast<T>(1 + (d + 1) * width + j), weight(rng));
+        }
+    for (std::uint64_t i = 0; i < width; ++i)
+        out.emplace_back(static_cast<T>(1 + (layers - 1) * width + i), static_cast<T>(sink), weight(rng));
+    return out;
+}
+
+}; // namespace generators
+
+}; // namespace Graph_implementation
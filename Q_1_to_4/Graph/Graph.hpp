@@ -12,32 +12,25 @@
 #include <vector>
 #include <set>
 #include <mutex>
-
-template <typename K> 
-struct Edge {
-    K vertex_w;
-    K vertex_r;
-    double edge_weight = 0.0;
-    double capacity = 0.0;
-    double current_flow = 0.0;
-
-    Edge(K v1, K v2, double w) : vertex_w(v1), vertex_r(v2), edge_weight(w) {}
-    Edge(K v1, K v2, double cap, double flow, int /*tag*/)
-        : vertex_w(v1), vertex_r(v2), capacity(cap), current_flow(flow) {}
-    // helper ctor for residual usage (cap,flow)
-    Edge(K v1, K v2, double cap, double flow) : Edge(v1, v2, cap, flow, 0) {}
-
-    ~Edge() = default;   
-    Edge() = default;      
-
-    void set_current_flow(double value) { current_flow = value; }
-    double residual_capacity() const { return capacity - current_flow; }
-    bool operator>(const Edge& other) const { return edge_weight > other.edge_weight; }
-
-    bool operator==(const Edge<K>& rhs) const {
-        return vertex_w == rhs.vertex_w && vertex_r == rhs.vertex_r;
-    }
-};
+#include <tuple>
+#include <utility>
+#include <cstdint>
+
+#include "Edge.hpp"
+#include "VertexIndex.hpp"
+#include "CSRGraph.hpp"
+#include "EdgeList.hpp"
+#include "UnionFind.hpp"
+#include "Snapshot.hpp"
+#include "Reorder.hpp"
+#include "Parallel.hpp"
+#include "Storage.hpp"
+#include "Cow.hpp"
+#include "Memory.hpp"
+#include "Generators.hpp"
+#include "Arena.hpp"
+#include "Delta.hpp"
+#include "FlowNetwork.hpp"
 
 namespace Graph_implementation{
 
@@ -58,14 +51,108 @@ struct edge_hash {
     }
 };
 
-template <typename T>
+// Storage selects the adjacency containers (see Storage.hpp); the default keeps the
+// original std::unordered_map layout.
+template <typename T, typename Storage = HashStorage>
 class Graph{
    private:
+    // Neighbors are keyed by vertex (weight as value) so edge lookup is O(1) expected.
+    using neighbor_map = typename Storage::template row_type<T>;
+    using adjacency_map = typename Storage::template map_type<T, neighbor_map>;
+    using index_type = typename Storage::template index_type<T>;
+    using id_type = typename VertexIndex<T>::id_type;
+
     size_t vertices_amount;
-    std::unordered_map<T, std::unordered_set<std::pair<T, double>, pair_hash>> graph;
+    adjacency_map graph;
+    index_type index_; // dense ids for every key of 'graph' (assigned on first insertion)
+    typename Storage::template vector_type<id_type> in_deg_; // in-degree by dense id (self-loops excluded), kept by add/remove_edge
     T start_vertex{};
     bool directed_{false}; // global graph mode
 
+    // Weak components by dense id (arc directions ignored), united on every edge insertion.
+    // remove_edge may split a component, so it marks them stale; the next insertion rebuilds
+    // them and queries in between fall back to a scan.
+    using components_type = UnionFind<typename Storage::template vector_type<id_type>>;
+    using scratch_sets = UnionFind<arena::scratch_vector<id_type>>; // throwaway rebuilds on the scratch resource
+    components_type components_;
+    size_t isolated_ = 0;        // vertices with no incident arc (each one is its own component)
+    bool components_stale_ = false;
+    size_t unbalanced_ = 0;      // odd-degree vertices (undirected) / in != out vertices (directed)
+
+    // Advanced by every effective mutation, once per apply()d delta (see Delta.hpp)
+    std::uint64_t version_ = 0;
+    bool batching_ = false;      // inside apply(): mutations only mark the batch dirty
+    bool batch_dirty_ = false;
+    VersionedCache<const CSRGraph<T>> csr_cache_; // snapshot()
+    // flow_network(): one slot shared with the copies of this graph until either side changes
+    using flow_cache_type = VersionedCache<FlowNetwork<T>>;
+    std::shared_ptr<flow_cache_type> flow_cache_ = std::make_shared<flow_cache_type>();
+
+    void bump_version_(){
+        ++version_;
+        if (flow_cache_.use_count() > 1) flow_cache_ = std::make_shared<flow_cache_type>();
+    }
+
+    void touch_(){
+        if (batching_) batch_dirty_ = true;
+        else bump_version_();
+    }
+
+    // Whether the vertex table can hold label v (only DenseStorage restricts labels).
+    template <typename M, typename = void>
+    struct has_accepts_ : std::false_type {};
+    template <typename M>
+    struct has_accepts_<M, std::void_t<decltype(M::accepts(std::declval<const T&>()))>> : std::true_type {};
+    static bool accepts_label_(const T& v){
+        if constexpr (has_accepts_<adjacency_map>::value) return adjacency_map::accepts(v);
+        else return true;
+    }
+
+    // Creates the adjacency entry, dense id and degree counter for a vertex not yet in 'graph'.
+    void new_vertex_(const T& v){
+        graph.try_emplace(v);
+        index_.intern(v);
+        in_deg_.push_back(0);
+        components_.add();
+        ++isolated_;
+    }
+
+    // No arc leaves or enters v (a self-loop counts as leaving).
+    bool isolated_vertex_(const T& v) const {
+        return graph.find(v)->second.empty() && in_deg_[index_.id_of(v)] == 0;
+    }
+
+    // Odd degree (undirected, a self-loop adds 1) or in-degree != out-degree (directed);
+    // the Euler degree condition holds iff no vertex is unbalanced.
+    bool unbalanced_vertex_(const T& v) const {
+        const size_t out = graph.find(v)->second.size();
+        return directed_ ? in_deg_[index_.id_of(v)] != out : out % 2 != 0;
+    }
+
+    // Re-counts v in unbalanced_ after its degrees changed ('was' = status before the change).
+    void retally_(const T& v, bool was){
+        unbalanced_ -= was;
+        unbalanced_ += unbalanced_vertex_(v);
+    }
+
+    // Unites every arc's endpoints into 'sets' (sized to the vertex count); returns the isolated count.
+    template <typename Sets>
+    size_t unite_all_(Sets& sets) const {
+        size_t isolated = 0;
+        for (const auto& [u, nbrs] : graph) {
+            const id_type iu = index_.id_of(u);
+            if (nbrs.empty() && in_deg_[iu] == 0) ++isolated;
+            for (const auto& [v, _w] : nbrs) sets.unite(iu, index_.id_of(v));
+        }
+        return isolated;
+    }
+
+    void rebuild_components_(){
+        components_.reset(index_.size());
+        isolated_ = unite_all_(components_);
+        components_stale_ = false;
+    }
+
    public:
   
     Graph(size_t amount, bool directed=false)
@@ -75,21 +162,90 @@ class Graph{
     Graph(const Graph &other):
         vertices_amount(other.vertices_amount),
         graph(other.graph),
+        index_(other.index_),
+        in_deg_(other.in_deg_),
+        start_vertex(other.start_vertex),
+        directed_(other.directed_),
+        components_(other.components_),
+        isolated_(other.isolated_),
+        components_stale_(other.components_stale_),
+        unbalanced_(other.unbalanced_),
+        version_(other.version_),
+        csr_cache_(other.csr_cache_),
+        flow_cache_(other.flow_cache_) {}
+
+    // Allocator-aware storage (PmrStorage): every container of the graph allocates from 'mr'.
+    Graph(size_t amount, bool directed, std::pmr::memory_resource* mr)
+        : vertices_amount(amount), graph(mr), index_(mr), in_deg_(mr), directed_(directed), components_(mr) {}
+
+    // Deep copy of 'other' whose containers allocate from 'mr' (PmrStorage), e.g. into a job arena.
+    Graph(const Graph &other, std::pmr::memory_resource* mr):
+        vertices_amount(other.vertices_amount),
+        graph(other.graph, mr),
+        index_(other.index_, mr),
+        in_deg_(other.in_deg_, mr),
         start_vertex(other.start_vertex),
-        directed_(other.directed_) {}
+        directed_(other.directed_),
+        components_(other.components_, mr),
+        isolated_(other.isolated_),
+        components_stale_(other.components_stale_),
+        unbalanced_(other.unbalanced_),
+        version_(other.version_),
+        csr_cache_(other.csr_cache_),
+        flow_cache_(other.flow_cache_) {}
 
     Graph& operator=(const Graph &other){
         if(this != &other) {
             vertices_amount = other.vertices_amount;
             graph = other.graph;
+            index_ = other.index_;
+            in_deg_ = other.in_deg_;
             start_vertex = other.start_vertex;
             directed_ = other.directed_;
+            components_ = other.components_;
+            isolated_ = other.isolated_;
+            components_stale_ = other.components_stale_;
+            unbalanced_ = other.unbalanced_;
+            version_ = other.version_;
+            csr_cache_ = other.csr_cache_;
+            flow_cache_ = other.flow_cache_;
+        }
+        return *this;
+    }
+    // Move semantics: the source keeps a fresh flow cache, so flow_network() never has to create one
+    Graph(Graph &&other):
+        vertices_amount(other.vertices_amount),
+        graph(std::move(other.graph)),
+        index_(std::move(other.index_)),
+        in_deg_(std::move(other.in_deg_)),
+        start_vertex(std::move(other.start_vertex)),
+        directed_(other.directed_),
+        components_(std::move(other.components_)),
+        isolated_(other.isolated_),
+        components_stale_(other.components_stale_),
+        unbalanced_(other.unbalanced_),
+        version_(other.version_),
+        csr_cache_(std::move(other.csr_cache_)),
+        flow_cache_(std::exchange(other.flow_cache_, std::make_shared<flow_cache_type>())) {}
+
+    Graph& operator=(Graph &&other){
+        if(this != &other) {
+            vertices_amount = other.vertices_amount;
+            graph = std::move(other.graph);
+            index_ = std::move(other.index_);
+            in_deg_ = std::move(other.in_deg_);
+            start_vertex = std::move(other.start_vertex);
+            directed_ = other.directed_;
+            components_ = std::move(other.components_);
+            isolated_ = other.isolated_;
+            components_stale_ = other.components_stale_;
+            unbalanced_ = other.unbalanced_;
+            version_ = other.version_;
+            csr_cache_ = std::move(other.csr_cache_);
+            flow_cache_ = std::exchange(other.flow_cache_, std::make_shared<flow_cache_type>());
         }
         return *this;
     }
-    // Move semantics
-    Graph(Graph &&other) = default;
-    Graph& operator=(Graph &&other) = default;
      
     bool is_directed() const { return directed_; }
 
@@ -100,71 +256,202 @@ class Graph{
                 // First inserted vertex becomes the start anchor
                 start_vertex = vertex;
             }
-            graph.emplace(vertex, std::unordered_set<std::pair<T,double>, pair_hash>{});
+            new_vertex_(vertex);
             // Keep vertices_amount synchronized with actual container size
             vertices_amount = graph.size();
+            touch_();
         }
     }
 
     T& get_first(){ return start_vertex; }
 
+    // Mutation counter: changes whenever the vertices, edges or weights change, so derived data
+    // stamped with an older value is stale. Copies start from the version of their source.
+    std::uint64_t version() const { return version_; }
+
+    // Dense id of every vertex (0..n-1, stable for the lifetime of the graph).
+    const index_type& vertex_index() const { return index_; }
+
+    // Estimated footprint of this graph: adjacency, vertex index and degree counters (see Memory.hpp).
+    MemoryUsage memory_usage() const {
+        MemoryUsage m;
+        m.bytes = sizeof(*this);
+        m += memory::of(graph);
+        m += memory::of(index_);
+        m += memory::of(in_deg_);
+        m += memory::of(components_);
+        return m;
+    }
+
     // Adds an edge using the graph's directedness flag.
     void add_edge(const T &u, const T &v, double w){
         // NOTE: external 'directed' param is ignored; we use directed_ consistently.
 
         // Ensure both endpoints exist to keep degrees/queries consistent
+        const size_t vertices_before = graph.size();
         if (graph.find(u) == graph.end()) {
             if (graph.empty()) start_vertex = u; // anchor on very first use
-            graph.emplace(u, std::unordered_set<std::pair<T,double>, pair_hash>{});
+            new_vertex_(u);
         }
         if (graph.find(v) == graph.end()) {
-            graph.emplace(v, std::unordered_set<std::pair<T,double>, pair_hash>{});
+            new_vertex_(v);
         }
         // Maintain vertices_amount invariant
         vertices_amount = graph.size();
+        if (components_stale_) rebuild_components_();
+        const size_t newly_touched = isolated_vertex_(u) + (u != v && isolated_vertex_(v));
+        const bool was_u = unbalanced_vertex_(u), was_v = u != v && unbalanced_vertex_(v);
+
+        // try_emplace keeps the first weight of an existing edge (no multi-edges)
+        if(!graph[u].try_emplace(v, w).second){
+            if (graph.size() != vertices_before) touch_();
+            return;
+        }
+        touch_();
+        if(u != v) ++in_deg_[index_.id_of(v)];
+        if(!directed_ && graph[v].try_emplace(u, w).second && u != v){
+            ++in_deg_[index_.id_of(u)];
+        }
+        isolated_ -= newly_touched;
+        components_.unite(index_.id_of(u), index_.id_of(v));
+        retally_(u, was_u);
+        if (u != v) retally_(v, was_v);
+    }
 
-        auto& nbrs_u = graph[u];
-
-        if(!directed_){
-            // Insert u<->v once (avoid multi-edges in the set)
-            auto it = std::find_if(nbrs_u.begin(), nbrs_u.end(),
-                [&](auto const &pr){ return pr.first == v; });
-            if(it == nbrs_u.end()){
-                graph[u].insert({v,w});
-                graph[v].insert({u,w});
+    // Bulk counterpart of add_edge for a whole edge list (u, v, w).
+    // Same semantics as calling add_edge in order (first weight wins, undirected edges
+    // are stored both ways), but the arcs are sorted and deduplicated up front and the
+    // adjacency rows are filled by several threads, each owning a disjoint set of rows.
+    using edge_tuple = std::tuple<T, T, double>;
+    void add_edges(const std::vector<edge_tuple>& edges){
+        if (edges.empty()) return;
+        const size_t vertices_before = graph.size();
+
+        // 1) Create missing vertices in input order so ids/start anchor match add_edge
+        for (const auto& [u, v, _w] : edges) {
+            if (graph.find(u) == graph.end()) {
+                if (graph.empty()) start_vertex = u;
+                new_vertex_(u);
             }
-        } else {
-            auto it = std::find_if(nbrs_u.begin(), nbrs_u.end(),
-                [&](auto const &pr){ return pr.first == v; });
-            if(it == nbrs_u.end()){
-                graph[u].insert({v,w});
+            if (graph.find(v) == graph.end()) new_vertex_(v);
+        }
+        vertices_amount = graph.size();
+
+        // 2) Expand to arcs; seq keeps input order so the first weight survives the dedupe
+        struct Arc { id_type from, to; std::size_t seq; double w; };
+        std::vector<Arc> arcs(directed_ ? edges.size() : 2 * edges.size());
+        const size_t fan = directed_ ? 1 : 2;
+        parallel::for_chunks(edges.size(), parallel::thread_count(edges.size()),
+            [&](size_t b, size_t e, size_t){
+                for (size_t i = b; i < e; ++i) {
+                    const auto& [u, v, w] = edges[i];
+                    const id_type iu = index_.id_of(u), iv = index_.id_of(v);
+                    arcs[fan * i] = Arc{iu, iv, i, w};
+                    if (!directed_) arcs[fan * i + 1] = Arc{iv, iu, i, w};
+                }
+            });
+        parallel::sort(arcs, [](const Arc& a, const Arc& b){
+            return std::tie(a.from, a.to, a.seq) < std::tie(b.from, b.to, b.seq);
+        });
+        arcs.erase(std::unique(arcs.begin(), arcs.end(), [](const Arc& a, const Arc& b){
+            return a.from == b.from && a.to == b.to;
+        }), arcs.end());
+
+        // 3) Row starts: arcs are grouped by source id after the sort
+        std::vector<size_t> row_begin;
+        for (size_t i = 0; i < arcs.size(); ++i)
+            if (i == 0 || arcs[i].from != arcs[i-1].from) row_begin.push_back(i);
+        row_begin.push_back(arcs.size());
+        std::vector<neighbor_map*> rows(row_begin.size() - 1);
+        for (size_t r = 0; r + 1 < row_begin.size(); ++r)
+            rows[r] = &graph[index_.vertex(arcs[row_begin[r]].from)];
+
+        // Endpoints still isolated now all get an arc below (an existing arc would have touched them);
+        // their balance is re-counted after the fill
+        if (components_stale_) rebuild_components_();
+        DenseBitset touched(index_.size());
+        std::vector<std::pair<id_type, bool>> ends; // (endpoint, unbalanced before)
+        for (const Arc& a : arcs) {
+            for (const id_type x : {a.from, a.to}) {
+                if (!touched.insert(x)) continue;
+                const T& label = index_.vertex(x);
+                if (isolated_vertex_(label)) --isolated_;
+                ends.emplace_back(x, unbalanced_vertex_(label));
             }
         }
+
+        // 4) Fill rows in parallel; inserted[] records which arcs were new
+        std::vector<char> inserted(arcs.size(), 0);
+        parallel::for_chunks(rows.size(), parallel::thread_count(arcs.size()),
+            [&](size_t b, size_t e, size_t){
+                for (size_t r = b; r < e; ++r) {
+                    neighbor_map& row = *rows[r];
+                    row.reserve(row.size() + (row_begin[r+1] - row_begin[r]));
+                    for (size_t i = row_begin[r]; i < row_begin[r+1]; ++i)
+                        inserted[i] = row.try_emplace(index_.vertex(arcs[i].to), arcs[i].w).second;
+                }
+            });
+
+        // 5) Degree counters and components (sequential: targets are shared between rows)
+        bool changed = graph.size() != vertices_before;
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            if (!inserted[i]) continue;
+            changed = true;
+            if (arcs[i].from != arcs[i].to) ++in_deg_[arcs[i].to];
+            components_.unite(arcs[i].from, arcs[i].to);
+        }
+        for (const auto& [x, was] : ends) retally_(index_.vertex(x), was);
+        if (changed) touch_();
     }
 
     void remove_edge(const T &u, const T &v){
         // Remove an edge u->v (or v->u for undirected) if it exists.
         if (graph.empty()) return; // no edges to remove
-        auto it_u = graph.find(u);
-        if (it_u == graph.end()) return;
+        if (!has_edge(u, v)) return;
+        const bool was_u = unbalanced_vertex_(u), was_v = u != v && unbalanced_vertex_(v);
+        touch_();
 
-        auto& nbrs_u = it_u->second;
+        // Weight-agnostic: erase the edge to v whatever its weight
+        graph[u].erase(v);
+        if (u != v) --in_deg_[index_.id_of(v)];
 
-        // Fallback: find any edge to v (weight-agnostic) and erase it
-        auto it = std::find_if(nbrs_u.begin(), nbrs_u.end(),
-                                [&](const auto& pr){ return pr.first == v; });
-        if (it != nbrs_u.end()) nbrs_u.erase(it);
-
-        if(!directed_){
+        if(!directed_ && has_edge(v, u)){
             // For undirected graphs, also remove the reverse edge
-            auto it_v = graph.find(v);
-            if (it_v != graph.end()) {
-                auto& nbrs_v = it_v->second;
-                auto it_rev = std::find_if(nbrs_v.begin(), nbrs_v.end(),
-                                           [&](const auto& pr){ return pr.first == u; });
-                if (it_rev != nbrs_v.end()) nbrs_v.erase(it_rev);
-            }
+            graph[v].erase(u);
+            if (u != v) --in_deg_[index_.id_of(u)];
+        }
+        retally_(u, was_u);
+        if (u != v) retally_(v, was_v);
+
+        // Components only split if u and v lost their last link (a remaining v->u keeps them joined)
+        if (components_stale_) return;
+        if (u == v) isolated_ += isolated_vertex_(u);
+        else if (!(directed_ && has_edge(v, u))) components_stale_ = true;
+    }
+
+    // Applies a whole delta as one mutation: its deletions, then its insertions (add_edges
+    // semantics, so an edge that survives the deletions keeps its weight). The version advances
+    // once if anything changed, so no cache is ever stamped with a half-applied delta.
+    // Every new label is checked against the storage first: a delta the graph cannot hold
+    // throws std::out_of_range and leaves the graph and version() untouched. Only an allocation
+    // failure midway can leave part of a delta applied (the version then still advances).
+    // Returns the resulting version.
+    std::uint64_t apply(const GraphDelta<T>& delta){
+        for (const auto& [u, v, _w] : delta.insertions)
+            if (!accepts_label_(u) || !accepts_label_(v))
+                throw std::out_of_range("Graph::apply: vertex label not valid for this storage");
+        batching_ = true;
+        batch_dirty_ = false;
+        auto end_batch = [this]{ batching_ = false; if (batch_dirty_) bump_version_(); };
+        try {
+            for (const auto& [u, v] : delta.deletions) remove_edge(u, v);
+            add_edges(delta.insertions);
+        } catch (...) {
+            end_batch(); // out of memory: whatever was applied still counts as a change
+            throw;
         }
+        end_batch();
+        return version_;
     }
 
     // ======================= Common helpers =======================
@@ -179,20 +466,18 @@ class Graph{
     }
 
     size_t in_degree(const T& v) const {
-        // O(V+E) scan. Consider caching if called frequently.
-        size_t deg = 0;
-        for (const auto& [u, nbrs] : graph) {
-            if (u != v){ 
-                for (const auto& pr : nbrs) {
-                    if (pr.first == v) { ++deg; break; }
-                }
-            }
-        }
-        return deg;
+        // O(1): maintained by add_edge/remove_edge. Self-loops are not counted.
+        const id_type id = index_.id_of(v);
+        return id != VertexIndex<T>::npos ? in_deg_[id] : 0;
     }
 
+    // Vertices failing the Euler degree condition: odd degree (undirected) or in != out (directed).
+    // Maintained by add_edge/add_edges/remove_edge, so a non-Eulerian graph is rejected in O(1).
+    size_t unbalanced_vertices() const { return unbalanced_; }
+
     bool all_even_degree() const{
         // Undirected check: every vertex has even degree
+        if (!directed_) return unbalanced_ == 0;
         for(const auto&[v,_]: graph){
             if(degree(v) % 2 != 0) return false;
         }
@@ -204,33 +489,20 @@ class Graph{
     // is connected when ignoring edge directions.
     // Used for checking weak connectivity in directed graphs (e.g., for Eulerian circuit).
     bool weakly_connected_nonzero() const {
-        // Build undirected adjacency list and collect all vertices with nonzero degree
-        std::unordered_map<T, std::vector<T>> und;
-        std::unordered_set<T> nonzero;
-        for (const auto& [u, nbrs] : graph) {
-            if (!nbrs.empty()) nonzero.insert(u); // vertex has outgoing edges
-            for (const auto& [v, _] : nbrs) {
-                und[u].push_back(v);   // add edge u-v
-                und[v].push_back(u);   // add edge v-u (undirected)
-                nonzero.insert(v);     // vertex has incoming edges
-            }
-        }
-        if (nonzero.empty()) return true; // trivial: no edges, considered connected
+        // Every vertex with an edge lies in one component <=> components - isolated vertices <= 1
+        if (!components_stale_) return components_.sets() - isolated_ <= 1;
+        scratch_sets sets(index_.size(), arena::scratch_resource());
+        const size_t isolated = unite_all_(sets);
+        return sets.sets() - isolated <= 1;
+    }
 
-        // DFS/BFS to check connectivity over nonzero-degree vertices
-        std::stack<T> st;
-        std::unordered_set<T> vis;
-        T start = *nonzero.begin();
-        st.push(start);
-        while (!st.empty()) {
-            T u = st.top(); st.pop();
-            if (vis.insert(u).second) {
-                for (auto& w : und[u]) if (!vis.count(w)) st.push(w);
-            }
-        }
-        // If any nonzero-degree vertex is not visited, not connected
-        for (auto& v : nonzero) if (!vis.count(v)) return false;
-        return true;
+    // Number of (weakly) connected components; isolated vertices count as one each. O(1) unless
+    // an edge was removed since the last insertion.
+    size_t component_count() const {
+        if (!components_stale_) return components_.sets();
+        scratch_sets sets(index_.size(), arena::scratch_resource());
+        unite_all_(sets);
+        return sets.sets();
     }
 
     // ======================= Euler =======================
@@ -245,23 +517,19 @@ class Graph{
 
    private:
     bool is_eulerian_undirected_impl() const {
-        return all_even_degree() && weakly_connected_nonzero();
+        return unbalanced_ == 0 && weakly_connected_nonzero();
     }
 
     bool is_eulerian_directed_impl() const {
-        if (!weakly_connected_nonzero()) return false;
-        for (const auto& [v, _] : graph) {
-            size_t in = in_degree(v), out = out_degree(v);
-            if ((in + out) > 0 && in != out) return false;
-        }
-        return true;
+        // Degree balance, then connectivity (both O(1) from the maintained counters)
+        return unbalanced_ == 0 && weakly_connected_nonzero();
     }
 
     /**
      * @brief Finds an Eulerian circuit in an undirected graph using Hierholzer's algorithm.
      *
      * This function checks if the graph is empty or not Eulerian, returning an empty vector in those cases.
-     * It constructs adjacency lists and uses a multiset to emulate edge removals for undirected graphs.
+     * It builds per-id multisets of neighbor ids to emulate edge removals for undirected graphs.
      * The algorithm starts from a vertex with edges and traverses the graph, removing edges as they are used,
      * and builds the Eulerian circuit in reverse order.
      *
@@ -275,20 +543,15 @@ class Graph{
         if (graph.empty()) return {}; // empty graph has no circuit
         if (!is_eulerian_undirected_impl()) return {};
 
-        // Build adjacency list for each vertex
-        std::unordered_map<T, std::vector<T>> adj;
+        // Use multiset (per dense id) to allow removal of edges as we traverse them
+        arena::scratch_vector<std::pmr::multiset<id_type>> ms(index_.size(), arena::scratch_resource());
         for (const auto& [u, s] : graph) {
-            for (const auto& [v,_w]: s) adj[u].push_back(v);
+            auto& row = ms[index_.id_of(u)];
+            for (const auto& [v,_w]: s) row.insert(index_.id_of(v));
         }
 
-        // Use multiset to allow removal of edges as we traverse them
-        std::unordered_map<T, std::multiset<T>> ms;
-        for (auto& [u, vs] : adj)
-            for (auto v: vs)
-                ms[u].insert(v);
-
         // Helper to erase both directions of an undirected edge
-        auto erase_und = [&](const T& a, const T& b){
+        auto erase_und = [&](id_type a, id_type b){
             auto it = ms[a].find(b);
             if (it!=ms[a].end()) ms[a].erase(it);
             it = ms[b].find(a);
@@ -300,21 +563,21 @@ class Graph{
         for (const auto& [u,s] : graph)
             if (!s.empty()) { start=u; break; }
 
-        std::stack<T> st;
+        std::stack<id_type, arena::scratch_vector<id_type>> st(arena::scratch_array<id_type>());
         std::vector<T> circ;
-        st.push(start);
+        st.push(index_.id_of(start));
 
         // Hierholzer's algorithm main loop
         while(!st.empty()){
-            T u = st.top();
+            id_type u = st.top();
             if (!ms[u].empty()){
                 // Traverse an unused edge
-                T v = *ms[u].begin();
+                id_type v = *ms[u].begin();
                 erase_und(u,v);
                 st.push(v);
             } else {
                 // No more edges from u, add to circuit
-                circ.push_back(u);
+                circ.push_back(index_.vertex(u));
                 st.pop();
             }
         }
@@ -326,35 +589,34 @@ class Graph{
         if (graph.empty()) return {}; // empty graph has no circuit
         if (!is_eulerian_directed_impl()) return {};
 
-        // Build adjacency list for each vertex (directed)
-        // Each vertex maps to a vector of its outgoing neighbors
-        std::unordered_map<T, std::vector<T>> adj; 
-        adj.reserve(graph.size());
+        // Build adjacency list for each vertex (directed), indexed by dense id
+        // Each id maps to a vector of its outgoing neighbor ids
+        arena::scratch_vector<arena::scratch_vector<id_type>> adj(index_.size(), arena::scratch_resource());
         for (const auto& [u, nbrs] : graph) {
-            auto& vec = adj[u];
+            auto& vec = adj[index_.id_of(u)];
             vec.reserve(nbrs.size());
-            for (const auto& [v, _w] : nbrs) vec.push_back(v);
+            for (const auto& [v, _w] : nbrs) vec.push_back(index_.id_of(v));
         }
 
-        // Map to track the current index of the next unused outgoing edge for each vertex
-        std::unordered_map<T, size_t> idx;
-        std::stack<T> st;
+        // Current index of the next unused outgoing edge for each vertex
+        auto idx = arena::scratch_array<size_t>(index_.size(), 0);
+        std::stack<id_type, arena::scratch_vector<id_type>> st(arena::scratch_array<id_type>());
         std::vector<T> circuit;
 
         // Find a starting vertex with at least one outgoing edge
         T start = graph.empty() ? T{} : graph.begin()->first;
         for (const auto& [u, nbrs] : graph) if (!nbrs.empty()) { start = u; break; }
 
-        st.push(start);
+        st.push(index_.id_of(start));
         // Hierholzer's algorithm main loop
         while (!st.empty()) {
-            T u = st.top();
+            id_type u = st.top();
             auto& vec = adj[u];
             size_t& i = idx[u];
             if (i < vec.size())
                 st.push(vec[i++]); // Traverse next unused outgoing edge
             else {
-                circuit.push_back(u); // No more edges from u, add to circuit
+                circuit.push_back(index_.vertex(u)); // No more edges from u, add to circuit
                 st.pop();
             }
         }
@@ -366,77 +628,75 @@ class Graph{
     // ======================= MST / Arborescence =======================
     // Public facade: same API name, internal dispatch.
     std::vector<Edge<T>> prims_algorithm(const T& root){
+        return spanning_edges(root).to_edges();
+    }
+
+    // Same tree as prims_algorithm, as (from, to, weight) columns (no per-edge Edge<T> objects).
+    WeightedEdgeList<T> spanning_edges(const T& root) const {
         return directed_ ? directed_arborescence_impl(root)
                          : prim_undirected_impl(root);
     }
 
    private:
-    std::vector<Edge<T>> prim_undirected_impl(const T& source){
+    WeightedEdgeList<T> prim_undirected_impl(const T& source) const {
         // Note: if the graph is disconnected, this returns an MST for the source's component only.
-        auto &adj_map = this->graph;
-        std::priority_queue<Edge<T>,std::vector<Edge<T>>,std::greater<Edge<T>>> pq;
-        std::unordered_set<T> inMST;
-        std::vector<Edge<T>> result;
+        if (!index_.contains(source)) return {};
+        // Heap entries are (weight, to, from) over dense ids: 16 bytes instead of an Edge<T>
+        struct Item { double w; id_type to, from; };
+        auto cmp = [](const Item& a, const Item& b){ return a.w > b.w; };
+        std::priority_queue<Item, arena::scratch_vector<Item>, decltype(cmp)> pq(cmp, arena::scratch_array<Item>());
+        DenseBitset inMST(index_.size());
+        WeightedEdgeList<T> result;
 
-        pq.push(Edge<T>(source,source,0.0)); // dummy
+        const id_type s = index_.id_of(source);
+        pq.push({0.0, s, s}); // dummy
 
         while(!pq.empty()){
-            Edge<T> top = pq.top(); pq.pop();
-            auto v = top.vertex_r;
-            auto u = top.vertex_w;
-            auto w = top.edge_weight;
-
-            if(inMST.count(v)) continue;
-
-            if(v != u) result.emplace_back(u, v, w); // store as (u->v, w)
-            inMST.insert(v);
+            const Item top = pq.top(); pq.pop();
+            if(!inMST.insert(top.to)) continue;
 
-            // If v does not exist (absent key), skip safely
-            auto it = adj_map.find(v);
-            if (it == adj_map.end()) continue;
+            const T& v = index_.vertex(top.to);
+            if(top.to != top.from) result.push_back(index_.vertex(top.from), v, top.w); // store as (u->v, w)
 
-            for(auto& [nbr,wt]: it->second){
-                if(!inMST.count(nbr)) pq.push(Edge<T>(v,nbr,wt));
+            for(const auto& [nbr,wt]: graph.find(v)->second){
+                const id_type id = index_.id_of(nbr);
+                if(!inMST.test(id)) pq.push({static_cast<double>(wt), id, top.to});
             }
         }
         return result;
     }
 
     // Chu–Liu/Edmonds (simplified reconstruction)
-    std::vector<Edge<T>> directed_arborescence_impl(const T& root) {
-        // Map nodes to indices
-        std::vector<T> nodes; nodes.reserve(graph.size());
-        std::unordered_map<T,int> id;
-        int idx=0;
-        for (auto& kv : graph) { id[kv.first]=idx++; nodes.push_back(kv.first); }
-        if (id.find(root)==id.end()) return {};
+    WeightedEdgeList<T> directed_arborescence_impl(const T& root) const {
+        // Nodes are addressed by their dense ids from the shared vertex index
+        const auto& nodes = index_.vertices();
+        if (!index_.contains(root)) return {};
 
         struct E { int u,v; double w; };
-        std::vector<E> edges;
-        for (auto& [u, nbrs] : graph) {
-            int iu = id[u];
-            for (auto& [v, w] : nbrs) {
-                int iv = id[v];
-                if (iu!=iv) edges.push_back({iu,iv,w});
+        auto edges = arena::scratch_array<E>();
+        for (const auto& [u, nbrs] : graph) {
+            int iu = static_cast<int>(index_.id_of(u));
+            for (const auto& [v, w] : nbrs) {
+                int iv = static_cast<int>(index_.id_of(v));
+                if (iu!=iv) edges.push_back({iu,iv,static_cast<double>(w)});
             }
         }
 
         int N = (int)nodes.size();
         if (N==0) return {};
-        int root_idx = id[root];
+        int root_idx = static_cast<int>(index_.id_of(root));
 
         double res = 0;
-        std::vector<int> pre, idc, vis;
-        std::vector<double> in;
+        auto pre = arena::scratch_array<int>(), idc = arena::scratch_array<int>(), vis = arena::scratch_array<int>();
+        auto in = arena::scratch_array<double>();
         int n = N;
-        std::vector<E> es = edges;
+        arena::scratch_vector<E> es(edges, arena::scratch_resource());
 
         auto get_weight_from_graph = [&](const T& a, const T& b)->double {
             auto it = graph.find(a);
             if (it != graph.end()) {
-                for (const auto& pr : it->second) {
-                    if (pr.first == b) return pr.second;
-                }
+                auto e = it->second.find(b);
+                if (e != it->second.end()) return e->second;
             }
             return 0.0; // fallback
         };
@@ -479,7 +739,7 @@ class Graph{
             }
             if (cnt == 0) {
                 // Build final edge list with REAL weights from the original graph
-                std::vector<Edge<T>> result;
+                WeightedEdgeList<T> result;
                 result.reserve(n-1);
                 for (int v=0; v<n; ++v) {
                     if (v==root_idx) continue;
@@ -488,14 +748,14 @@ class Graph{
                     const T from = nodes[u];
                     const T to   = nodes[v];
                     double w = get_weight_from_graph(from, to);
-                    result.emplace_back(from, to, w);
+                    result.push_back(from, to, w);
                 }
                 return result;
             }
 
             for (int i=0;i<n;i++) if (idc[i] == -1) idc[i] = cnt++;
 
-            std::vector<E> nes; nes.reserve(es.size());
+            auto nes = arena::scratch_array<E>(); nes.reserve(es.size());
             for (auto &e : es) {
                 int u = idc[e.u], v = idc[e.v];
                 double w = e.w;
@@ -516,17 +776,42 @@ class Graph{
                          : connected_components_impl();
     }
 
-   private:
-    using adj_list = std::unordered_map<T,std::unordered_set<std::pair<T,double>,pair_hash>>;
+    // Same, with the chosen engine for directed graphs (see SccEngine in CSRGraph.hpp). Kosaraju
+    // and Tarjan list the components in a topological order of the condensation (not necessarily
+    // the same one); the parallel engine runs on the cached snapshot() and lists them by their
+    // first vertex. An undirected graph gets its connected components, with SccEngine::parallel
+    // from Afforest on the snapshot. 'threads' is used by SccEngine::parallel only (0 = sized to
+    // the graph).
+    std::vector<std::vector<T>> strongly_connected_components(SccEngine engine = SccEngine::kosaraju,
+                                                              std::size_t threads = 0){
+        if (!directed_) return engine == SccEngine::parallel ? afforest_components_(threads) : connected_components_impl();
+        switch (engine) {
+            case SccEngine::tarjan:   return tarjan_directed_impl();
+            case SccEngine::parallel: return snapshot()->strongly_connected_components(engine, threads);
+            default:                  return kosaraju_directed_impl();
+        }
+    }
 
-    adj_list transpose_graph_directed_() const {
-        // Reverse all directed edges
-        adj_list reversed;
-        for(const auto& [v,_] : graph) reversed[v] = {};
-        for(const auto& [u,values] : graph)
-            for(auto& [v,w] : values)
-                reversed[v].insert({u,w});
-        return reversed;
+   private:
+    // Reversed arcs by dense id, CSR-style (in_off[v]..in_off[v+1] are the sources of arcs into v)
+    struct Transposed{
+        arena::scratch_vector<size_t> in_off;
+        arena::scratch_vector<id_type> in_src;
+    };
+
+    Transposed transpose_graph_directed_() const {
+        Transposed gt{arena::scratch_array<size_t>(index_.size() + 1, 0), arena::scratch_array<id_type>()};
+        for (const auto& [u,values] : graph)
+            for (const auto& [v,_w] : values) ++gt.in_off[index_.id_of(v) + 1];
+        for (size_t i = 1; i < gt.in_off.size(); ++i) gt.in_off[i] += gt.in_off[i-1];
+        gt.in_src.resize(gt.in_off.back());
+        auto fill = arena::scratch_array<size_t>();
+        fill.assign(gt.in_off.begin(), gt.in_off.end() - 1);
+        for (const auto& [u,values] : graph) {
+            const id_type uid = index_.id_of(u);
+            for (const auto& [v,_w] : values) gt.in_src[fill[index_.id_of(v)]++] = uid;
+        }
+        return gt;
     }
 
     // NOTE: kept for backward compatibility, but not used anymore.
@@ -546,53 +831,53 @@ class Graph{
         }
     }
 
-    void second_dfs(const T& vertex, const adj_list& gt,
-                    std::unordered_set<T>& vis, std::vector<T>& comp){
+    void second_dfs(id_type vertex, const Transposed& gt,
+                    DenseBitset& vis, std::vector<T>& comp){
         // Standard iterative DFS on the transposed graph
-        std::stack<T> st; st.push(vertex);
-        vis.insert(vertex);
+        std::stack<id_type, arena::scratch_vector<id_type>> st(arena::scratch_array<id_type>());
+        st.push(vertex);
+        vis.set(vertex);
         while(!st.empty()){
             auto u = st.top(); st.pop();
-            comp.push_back(u);
-            for(const auto& [nbr,_] : gt.at(u))
-                if(!vis.count(nbr)){ vis.insert(nbr); st.push(nbr); }
+            comp.push_back(index_.vertex(u));
+            for (size_t a = gt.in_off[u]; a < gt.in_off[u+1]; ++a)
+                if(vis.insert(gt.in_src[a])) st.push(gt.in_src[a]);
         }
     }
 
     std::vector<std::vector<T>> kosaraju_directed_impl(){
         // Fixed first pass: one global 'vis' shared across all starts, computing a single order stack.
-        std::unordered_set<T> vis;
-        std::stack<T> order;
+        DenseBitset vis(index_.size());
+        std::stack<id_type, arena::scratch_vector<id_type>> order(arena::scratch_array<id_type>());
 
         // Local lambda to perform DFS and record finish order
         auto dfs1 = [&](const T& s){
-            std::stack<std::pair<T,bool>> st;
+            std::stack<std::pair<T,bool>, arena::scratch_vector<std::pair<T,bool>>> st(arena::scratch_array<std::pair<T,bool>>());
             st.push({s,false});
             while(!st.empty()){
                 auto [u,back] = st.top(); st.pop();
-                if (back) { order.push(u); continue; }
-                if (vis.count(u)) continue;
-                vis.insert(u);
+                if (back) { order.push(index_.id_of(u)); continue; }
+                if (!vis.insert(index_.id_of(u))) continue;
                 st.push({u,true}); // postorder marker
                 auto it = graph.find(u);
                 if (it != graph.end()) {
                     for (const auto& [nbr,_w] : it->second) {
-                        if (!vis.count(nbr)) st.push({nbr,false});
+                        if (!vis.test(index_.id_of(nbr))) st.push({nbr,false});
                     }
                 }
             }
         };
 
         for (const auto& [v,_] : graph) {
-            if (!vis.count(v)) dfs1(v);
+            if (!vis.test(index_.id_of(v))) dfs1(v);
         }
 
-        auto gt = transpose_graph_directed_();
+        const Transposed gt = transpose_graph_directed_();
         vis.clear();
         std::vector<std::vector<T>> res;
         while(!order.empty()){
-            T v = order.top(); order.pop();
-            if (!vis.count(v)){
+            id_type v = order.top(); order.pop();
+            if (!vis.test(v)){
                 std::vector<T> comp;
                 second_dfs(v, gt, vis, comp);
                 res.emplace_back(std::move(comp));
@@ -601,100 +886,139 @@ class Graph{
         return res;
     }
 
+    // Iterative Tarjan: each DFS frame keeps its position in the vertex's own neighbor row, so
+    // no transposed graph is built. Extra memory is the discovery and low-link numbers, the
+    // component stack and the DFS frames, all O(V). Components complete in reverse topological
+    // order of the condensation; they are reversed at the end to list sources first, like Kosaraju.
+    std::vector<std::vector<T>> tarjan_directed_impl() const {
+        using row_iterator = decltype(std::cbegin(std::declval<const neighbor_map&>()));
+        struct Frame{ id_type v = 0; const neighbor_map* row = nullptr; row_iterator next{}; };
+        constexpr id_type unseen = VertexIndex<T>::npos;
+        const size_t n = index_.size();
+        auto order = arena::scratch_array<id_type>(n, unseen); // discovery number
+        auto low = arena::scratch_array<id_type>(n, 0);
+        DenseBitset on_stack(n);
+        auto stack = arena::scratch_array<id_type>();
+        auto frames = arena::scratch_array<Frame>();
+        id_type counter = 0;
+        std::vector<std::vector<T>> res;
+
+        auto visit = [&](id_type v){
+            order[v] = low[v] = counter++;
+            stack.push_back(v);
+            on_stack.set(v);
+            auto it = graph.find(index_.vertex(v));
+            if (it == graph.end()) frames.push_back({v, nullptr, row_iterator{}});
+            else frames.push_back({v, &it->second, std::cbegin(it->second)});
+        };
+
+        for (const auto& [root,_] : graph) {
+            if (order[index_.id_of(root)] != unseen) continue;
+            visit(index_.id_of(root));
+            while (!frames.empty()) {
+                Frame& f = frames.back();
+                if (f.row && f.next != std::cend(*f.row)) {
+                    const auto& [nbr,_w] = *f.next;
+                    const id_type w = index_.id_of(nbr);
+                    ++f.next;
+                    if (order[w] == unseen) visit(w); // f is not used past this point
+                    else if (on_stack.test(w)) low[f.v] = std::min(low[f.v], order[w]);
+                    continue;
+                }
+                const id_type v = f.v;
+                frames.pop_back();
+                if (!frames.empty()) low[frames.back().v] = std::min(low[frames.back().v], low[v]);
+                if (low[v] != order[v]) continue;
+                std::vector<T> comp;
+                id_type w;
+                do {
+                    w = stack.back(); stack.pop_back();
+                    on_stack.reset(w);
+                    comp.push_back(index_.vertex(w));
+                } while (w != v);
+                res.emplace_back(std::move(comp));
+            }
+        }
+        std::reverse(res.begin(), res.end());
+        return res;
+    }
+
     std::vector<std::vector<T>> connected_components_impl() const {
-        std::unordered_set<T> vis;
+        // Group vertices by their union-find root; components appear in order of their first vertex.
+        // After removals the sets are out of date: relabel the snapshot in parallel instead.
+        if (components_stale_) return afforest_components_(0);
+        return group_components_(components_);
+    }
+
+    // Per-id labels of CSRGraph::component_labels() behind the find()/sets() of a UnionFind
+    struct LabelSets{
+        std::vector<id_type> label;
+        size_t count = 0;
+        id_type find(id_type v) const { return label[v]; }
+        size_t sets() const { return count; }
+    };
+
+    // Afforest over the cached snapshot(), grouped exactly like the union-find path
+    std::vector<std::vector<T>> afforest_components_(size_t threads) const {
+        LabelSets sets{snapshot()->component_labels(threads)};
+        for (id_type v = 0; v < static_cast<id_type>(sets.label.size()); ++v) sets.count += sets.label[v] == v;
+        return group_components_(sets);
+    }
+
+    template <typename Sets>
+    std::vector<std::vector<T>> group_components_(const Sets& sets) const {
+        auto slot = arena::scratch_array<id_type>(index_.size(), VertexIndex<T>::npos);
         std::vector<std::vector<T>> comps;
-        for (const auto& [s,_] : graph) {
-            if (vis.count(s)) continue;
-            std::vector<T> comp;
-            std::stack<T> st; st.push(s); vis.insert(s);
-            while (!st.empty()) {
-                T u = st.top(); st.pop();
-                comp.push_back(u);
-                for (const auto& [v,_w] : graph.at(u))
-                    if (!vis.count(v)) { vis.insert(v); st.push(v); }
+        comps.reserve(sets.sets());
+        for (const auto& [v, _] : graph) {
+            const id_type root = sets.find(index_.id_of(v));
+            if (slot[root] == VertexIndex<T>::npos) {
+                slot[root] = static_cast<id_type>(comps.size());
+                comps.emplace_back();
             }
-            comps.push_back(std::move(comp));
+            comps[slot[root]].push_back(v);
         }
         return comps;
     }
 
    public:
-    // ======================= Max-Flow (Edmonds–Karp) =======================
+    // ======================= Max-Flow (Edmonds–Karp / Dinic / push–relabel) =======================
     double edmon_karp_algorithm(const T& source, const T& sink){
-        using residual_graph = std::unordered_map<T,std::vector<Edge<T>>>;
-        auto convert_to_residual = [&](){
-            // Build residual graph: forward edges with capacity=weight; ensure reverse edges exist with 0 cap.
-            residual_graph rs;
-            for (const auto& [u, neighbors] : graph) {
-                for (const auto& [v, cap] : neighbors) {
-                    rs[u].emplace_back(u, v, cap, 0.0);
-                    // Ensure existence of both endpoint keys
-                    if (!rs.count(v)) rs[v] = {};
-                }
-            }
-            // Add missing reverse edges with zero capacity
-            for (const auto& [u, neighbors] : graph) {
-                for (const auto& [v, cap] : neighbors) {
-                    (void)cap;
-                    bool rev = false;
-                    if (rs.count(v))
-                        for (const auto& e : rs.at(v)) if (e.vertex_r == u){ rev=true; break; }
-                    if (!rev) rs[v].emplace_back(v, u, 0.0, 0.0);
-                }
-            }
-            return rs;
-        };
+        return max_flow(source, sink, FlowEngine::edmonds_karp);
+    }
 
-        auto bfs = [&](const residual_graph& rs, std::unordered_map<T,T>& parent)->bool{
-            // Standard BFS on residual graph to find augmenting path
-            std::unordered_set<T> vis;
-            std::queue<T> q; q.push(source); vis.insert(source);
-            while(!q.empty()){
-                T u=q.front(); q.pop();
-                auto it = rs.find(u);
-                if (it==rs.end()) continue;
-                for (const auto& e : it->second){
-                    if (e.residual_capacity()>0 && !vis.count(e.vertex_r)){
-                        parent[e.vertex_r]=u;
-                        if (e.vertex_r==sink) return true;
-                        vis.insert(e.vertex_r);
-                        q.push(e.vertex_r);
-                    }
-                }
-            }
-            return false;
-        };
+    // Max-flow value with the chosen engine (see FlowEngine in EdgeList.hpp), answered by the
+    // cached flow_network(): repeated queries on an unchanged graph skip the residual build.
+    // 'threads' is used by parallel_push_relabel only (0 = all hardware threads).
+    double max_flow(const T& source, const T& sink, FlowEngine engine = FlowEngine::edmonds_karp,
+                    std::size_t threads = 0) const {
+        if (!index_.contains(source) || !index_.contains(sink)) return 0.0;
+        return flow_network()->max_flow(source, sink, engine, threads);
+    }
 
-        auto rs = convert_to_residual();
-        double flow=0.0;
-        std::unordered_map<T,T> parent;
-
-        while(bfs(rs,parent)){
-            // Find bottleneck capacity along the path
-            double add = std::numeric_limits<double>::infinity();
-            for (T v=sink; v!=source; v=parent[v]){
-                T u = parent[v];
-                for (const auto& e : rs[u])
-                    if (e.vertex_r==v){ add = std::min(add, e.residual_capacity()); break; }
-            }
-            // Augment along the path
-            for (T v=sink; v!=source; v=parent[v]){
-                T u = parent[v];
-                for (auto &e : rs[u]) if (e.vertex_r==v){ e.current_flow += add; break; }
-                for (auto &e : rs[v]) if (e.vertex_r==u){ e.current_flow -= add; break; }
+    // Reusable max-flow network of the current version (see FlowNetwork.hpp), built on first use
+    // and kept until the next mutation. Copies of the graph share it until either side changes.
+    std::shared_ptr<FlowNetwork<T>> flow_network() const {
+        return flow_cache_->get(version_, [this]{ return FlowNetwork<T>(snapshot()); });
+    }
+
+    // Residual network over the graph's dense ids: forward arcs carry the edge weight as capacity,
+    // each paired with a zero-capacity reverse arc (see EdgeList.hpp).
+    ResidualNetwork residual_network() const {
+        return ResidualNetwork::from_arcs(index_.size(), [this](auto&& f){
+            for (const auto& [u, neighbors] : graph) {
+                const id_type iu = index_.id_of(u);
+                for (const auto& [v, cap] : neighbors) f(iu, index_.id_of(v), static_cast<double>(cap));
             }
-            flow += add;
-            parent.clear();
-        }
-        return flow;
+        });
     }
 
     // ======================= Hamilton =======================
     const std::vector<T> hamilton_cycle(const T& start){
         std::vector<T> path; path.reserve(vertices_amount+1);
-        std::unordered_set<T> vis;
-        path.push_back(start); vis.insert(start);
+        if (!index_.contains(start)) return {};
+        DenseBitset vis(index_.size());
+        path.push_back(start); vis.set(index_.id_of(start));
         if (dfs_hamilton_impl(start,start,path,vis)) return path;
         return {};
     }
@@ -702,15 +1026,13 @@ class Graph{
    private:
     bool has_edge(const T& a,const T& b)const{
         auto it = graph.find(a);
-        if(it == graph.end()) return false;
-        return std::any_of(it->second.begin(), it->second.end(),
-                           [&](const auto& pr){ return pr.first == b; });
+        return it != graph.end() && it->second.count(b) != 0;
     }
 
     bool dfs_hamilton_impl(const T& v,
                            const T& start,
                            std::vector<T>& path,
-                           std::unordered_set<T>& vis){
+                           DenseBitset& vis){
         // Use actual graph size instead of vertices_amount to avoid stale counts
         if(path.size() == graph.size()){
             if(has_edge(v,start)){ path.push_back(start); return true; }
@@ -719,18 +1041,37 @@ class Graph{
         auto it = graph.find(v);
         if (it == graph.end()) return false;
         for(const auto& [nbr,_w]: it->second){
-            if(!vis.count(nbr)){
-                vis.insert(nbr);
+            const id_type id = index_.id_of(nbr);
+            if(vis.insert(id)){
                 path.push_back(nbr);
                 if (dfs_hamilton_impl(nbr,start,path,vis)) return true;
                 path.pop_back();
-                vis.erase(nbr);
+                vis.reset(id);
             }
         }
         return false;
     }
 
    public:
+    // ======================= CSR snapshot =======================
+    // Immutable compressed-sparse-row copy of the current adjacency (dense ids, contiguous arcs).
+    // Run several algorithms on the snapshot to pay the hash-map walk only once.
+    CSRGraph<T> freeze() const {
+        return CSRGraph<T>(graph, index_, directed_);
+    }
+
+    // Shared CSR snapshot of the current version: built on first use, then reused until the next
+    // mutation (see VersionedCache in Delta.hpp). Safe to call from several readers at once.
+    std::shared_ptr<const CSRGraph<T>> snapshot() const {
+        return csr_cache_.get(version_, [this]{ return freeze(); });
+    }
+
+    // Same snapshot with the vertices renumbered for locality (see Reorder.hpp); results are
+    // still reported with the original labels.
+    CSRGraph<T> freeze(VertexOrder order) const {
+        return reorder(freeze(), order);
+    }
+
     // ======================= Formatting helpers =======================
     std::string to_string_with_weights(bool as_capacity=false) const {
         std::ostringstream os;
@@ -749,12 +1090,12 @@ class Graph{
         return os.str();
     }
 
-    template<typename U>
-    friend std::ostream& operator<<(std::ostream&, const Graph<U>&);
+    template<typename U, typename S>
+    friend std::ostream& operator<<(std::ostream&, const Graph<U, S>&);
 };
 
-template <typename T>
-std::ostream &operator<<(std::ostream &os, const Graph<T> &other) {
+template <typename T, typename Storage>
+std::ostream &operator<<(std::ostream &os, const Graph<T, Storage> &other) {
     os << "{\n";
     for(const auto& [vertex,neighbors] : other.graph){
         os << " " << vertex << " : [ ";
@@ -0,0 +1,101 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+namespace Graph_implementation{
+
+/*
+ * Memory accounting for graphs and their storage containers (Graph::memory_usage()).
+ *
+ * Figures are estimates of the heap a container owns, computed from element sizes,
+ * capacities and bucket counts (libstdc++ node layout, allocator headers not counted):
+ *   nodes    separately allocated nodes (hash-map nodes, shared blocks)
+ *   buckets  bucket / slot array entries
+ *   bytes    heap bytes owned, recursively including the elements' own heap
+ * Shared copy-on-write blocks are counted in full by every snapshot that reaches them.
+ */
+struct MemoryUsage{
+    std::size_t nodes = 0;
+    std::size_t buckets = 0;
+    std::size_t bytes = 0;
+
+    MemoryUsage& operator+=(const MemoryUsage& o) {
+        nodes += o.nodes; buckets += o.buckets; bytes += o.bytes;
+        return *this;
+    }
+};
+
+namespace memory{
+
+// heap_usage<X>::of(x): heap owned by x, excluding sizeof(X) itself (the owner counts that).
+// Containers of this library provide a memory_usage() member; std ones are specialised below.
+template <typename X, typename = void>
+struct heap_usage{
+    static MemoryUsage of(const X&) { return {}; }
+};
+
+template <typename X>
+MemoryUsage of(const X& x) { return heap_usage<X>::of(x); }
+
+template <typename X>
+struct heap_usage<X, std::void_t<decltype(std::declval<const X&>().memory_usage())>>{
+    static MemoryUsage of(const X& x) { return x.memory_usage(); }
+};
+
+template <typename A, typename B>
+struct heap_usage<std::pair<A, B>>{
+    static MemoryUsage of(const std::pair<A, B>& p) {
+        MemoryUsage m = memory::of(p.first);
+        m += memory::of(p.second);
+        return m;
+    }
+};
+
+template <typename X, typename Alloc>
+struct heap_usage<std::vector<X, Alloc>>{
+    static MemoryUsage of(const std::vector<X, Alloc>& v) {
+        MemoryUsage m;
+        m.bytes = v.capacity() * sizeof(X);
+        if constexpr (!std::is_trivially_copyable<X>::value)
+            for (const auto& x : v) m += memory::of(x);
+        return m;
+    }
+};
+
+template <typename X>
+struct heap_usage<std::shared_ptr<X>>{
+    static MemoryUsage of(const std::shared_ptr<X>& p) {
+        MemoryUsage m;
+        if (!p) return m;
+        m.nodes = 1;
+        m.bytes = sizeof(X) + 2 * sizeof(long); // make_shared control block (two counters)
+        m += memory::of(*p);
+        return m;
+    }
+};
+
+template <typename K, typename V, typename H, typename E, typename Alloc>
+struct heap_usage<std::unordered_map<K, V, H, E, Alloc>>{
+    static MemoryUsage of(const std::unordered_map<K, V, H, E, Alloc>& map) {
+        using value_type = std::pair<const K, V>;
+        // libstdc++ node: next pointer + value (+ cached hash unless the hash is "fast", i.e. integral keys)
+        constexpr std::size_t align = alignof(value_type) > alignof(void*) ? alignof(value_type) : alignof(void*);
+        constexpr std::size_t raw = sizeof(void*) + sizeof(value_type) + (std::is_integral<K>::value ? 0 : sizeof(std::size_t));
+        constexpr std::size_t node = (raw + align - 1) / align * align;
+
+        MemoryUsage m;
+        m.nodes = map.size();
+        m.buckets = map.bucket_count();
+        m.bytes = map.size() * node + map.bucket_count() * sizeof(void*);
+        for (const auto& [k, v] : map) { m += memory::of(k); m += memory::of(v); }
+        return m;
+    }
+};
+
+}; // namespace memory
+
+}; // namespace Graph_implementation
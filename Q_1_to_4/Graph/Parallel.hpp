@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+#include <utility>
+
+namespace Graph_implementation{
+
+/*
+ * Minimal fork-join helpers for the bulk graph builders.
+ * Work is split into contiguous chunks, one std::thread per chunk; inputs
+ * below 'serial_cutoff' run inline on the calling thread.
+ * Iterative kernels that alternate many short parallel phases use team() instead:
+ * the threads are started once and meet at a Barrier between phases.
+ */
+namespace parallel{
+
+constexpr std::size_t serial_cutoff = 1u << 14;
+
+inline std::size_t thread_count(std::size_t work_items) {
+    if (work_items < serial_cutoff) return 1;
+    std::size_t hw = std::thread::hardware_concurrency();
+    if (hw == 0) hw = 2;
+    return std::min<std::size_t>(hw, (work_items + serial_cutoff - 1) / serial_cutoff);
+}
+
+// Calls f(begin, end, chunk) for 'chunks' contiguous ranges covering [0, n).
+template <typename F>
+void for_chunks(std::size_t n, std::size_t chunks, F&& f) {
+    if (chunks <= 1 || n == 0) { f(std::size_t{0}, n, std::size_t{0}); return; }
+    const std::size_t step = (n + chunks - 1) / chunks;
+    std::vector<std::thread> pool;
+    pool.reserve(chunks - 1);
+    for (std::size_t c = 1; c < chunks; ++c) {
+        const std::size_t b = std::min(n, c * step), e = std::min(n, b + step);
+        pool.emplace_back([&f, b, e, c]{ f(b, e, c); });
+    }
+    f(std::size_t{0}, std::min(n, step), std::size_t{0});
+    for (auto& t : pool) t.join();
+}
+
+// Reusable rendezvous for a fixed number of threads (std::barrier is C++20).
+class Barrier{
+   public:
+    explicit Barrier(std::size_t parties) : parties_(parties) {}
+
+    void arrive_and_wait() {
+        std::unique_lock<std::mutex> lk(mtx_);
+        const std::size_t gen = generation_;
+        if (++waiting_ == parties_) {
+            waiting_ = 0;
+            ++generation_;
+            cv_.notify_all();
+            return;
+        }
+        cv_.wait(lk, [&]{ return generation_ != gen; });
+    }
+
+   private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::size_t parties_, waiting_ = 0, generation_ = 0;
+};
+
+// Runs f(worker, workers, barrier) on 'workers' threads (the caller is worker 0) and joins them.
+// Every worker must make the same sequence of barrier calls.
+template <typename F>
+void team(std::size_t workers, F&& f) {
+    workers = std::max<std::size_t>(workers, 1);
+    Barrier barrier(workers);
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w) pool.emplace_back([&f, &barrier, w, workers]{ f(w, workers, barrier); });
+    f(std::size_t{0}, workers, barrier);
+    for (auto& t : pool) t.join();
+}
+
+// [begin, end) of worker w's share when n items are split over 'workers' workers.
+inline std::pair<std::size_t, std::size_t> share(std::size_t n, std::size_t w, std::size_t workers) {
+    const std::size_t step = (n + workers - 1) / workers;
+    return {std::min(n, w * step), std::min(n, (w + 1) * step)};
+}
+
+// Sorts chunks concurrently, then merges neighbouring runs pairwise.
+template <typename Vec, typename Cmp>
+void sort(Vec& v, Cmp cmp) {
+    const std::size_t n = v.size();
+    const std::size_t chunks = thread_count(n);
+    if (chunks <= 1) { std::sort(v.begin(), v.end(), cmp); return; }
+
+    const std::size_t step = (n + chunks - 1) / chunks;
+    for_chunks(n, chunks, [&](std::size_t b, std::size_t e, std::size_t){
+        std::sort(v.begin() + b, v.begin() + e, cmp);
+    });
+    for (std::size_t width = step; width < n; width *= 2) {
+        const std::size_t pairs = (n + 2 * width - 1) / (2 * width);
+        for_chunks(pairs, pairs, [&](std::size_t pb, std::size_t pe, std::size_t){
+            for (std::size_t p = pb; p < pe; ++p) {
+                const std::size_t b = p * 2 * width;
+                const std::size_t m = std::min(n, b + width), e = std::min(n, b + 2 * width);
+                if (m < e) std::inplace_merge(v.begin() + b, v.begin() + m, v.begin() + e, cmp);
+            }
+        });
+    }
+}
+
+}; // namespace parallel
+
+}; // namespace Graph_implementation
@@ -0,0 +1,148 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+
+#include "CSRGraph.hpp"
+#include "VertexIndex.hpp"
+#include "Column.hpp"
+#include "Parallel.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Cache-locality relabeling of a CSR snapshot.
+ * Ids of a frozen Graph follow insertion order, i.e. whatever order the client sent, so
+ * BFS/DFS kernels jump around the arrays. reorder() renumbers the vertices so neighbours get
+ * nearby ids and returns a new CSRGraph; its VertexIndex maps every new id back to the original
+ * label, so all algorithm results are still reported in the caller's vertex labels.
+ *
+ *   degree : highest degree first (hubs share the first cache lines)
+ *   bfs    : breadth-first discovery order, component by component
+ *   rcm    : reverse Cuthill–McKee (BFS from a low-degree vertex, neighbours by ascending degree,
+ *            whole order reversed): small bandwidth, good for mesh/road-like graphs
+ *
+ * Directed graphs are ordered on their undirected shape (out- and in-arcs).
+ */
+enum class VertexOrder{ original, degree, bfs, rcm };
+
+namespace reorder_detail{
+
+// Undirected adjacency over ids: the arcs themselves, plus the reversed arcs for directed graphs
+template <typename T>
+struct SymmetricView{
+    using id_type = typename CSRGraph<T>::id_type;
+    const CSRGraph<T>& g;
+    std::vector<std::size_t> in_off;
+    std::vector<id_type> in_src;
+
+    explicit SymmetricView(const CSRGraph<T>& graph) : g(graph) {
+        if (!g.is_directed()) return;
+        const std::size_t n = g.vertex_count();
+        in_off.assign(n + 1, 0);
+        for (id_type v : g.targets()) ++in_off[v + 1];
+        std::partial_sum(in_off.begin(), in_off.end(), in_off.begin());
+        in_src.resize(g.arc_count());
+        std::vector<std::size_t> fill(in_off.begin(), in_off.end() - 1);
+        for (id_type u = 0; u < n; ++u)
+            for (std::size_t a = g.arc_begin(u); a < g.arc_end(u); ++a) in_src[fill[g.target(a)]++] = u;
+    }
+
+    std::size_t degree(id_type u) const {
+        return g.degree(u) + (g.is_directed() ? in_off[u + 1] - in_off[u] : 0);
+    }
+    template <typename F>
+    void for_each(id_type u, F&& f) const {
+        for (std::size_t a = g.arc_begin(u); a < g.arc_end(u); ++a) f(g.target(a));
+        if (g.is_directed())
+            for (std::size_t a = in_off[u]; a < in_off[u + 1]; ++a) f(in_src[a]);
+    }
+};
+
+}; // namespace reorder_detail
+
+// New numbering as order[new_id] = old_id.
+template <typename T>
+std::vector<typename CSRGraph<T>::id_type> vertex_order(const CSRGraph<T>& g, VertexOrder how) {
+    using id_type = typename CSRGraph<T>::id_type;
+    const id_type n = static_cast<id_type>(g.vertex_count());
+    std::vector<id_type> order(n);
+    std::iota(order.begin(), order.end(), id_type{0});
+    if (how == VertexOrder::original || n == 0) return order;
+
+    const reorder_detail::SymmetricView<T> view(g);
+    if (how == VertexOrder::degree) {
+        std::stable_sort(order.begin(), order.end(), [&](id_type a, id_type b){ return view.degree(a) > view.degree(b); });
+        return order;
+    }
+
+    // bfs / rcm: the order vector doubles as the BFS queue
+    const bool rcm = how == VertexOrder::rcm;
+    std::vector<id_type> starts(order);
+    if (rcm) std::stable_sort(starts.begin(), starts.end(), [&](id_type a, id_type b){ return view.degree(a) < view.degree(b); });
+    DenseBitset seen(n);
+    std::size_t tail = 0;
+    for (id_type s : starts) {
+        if (!seen.insert(s)) continue;
+        std::size_t head = tail;
+        order[tail++] = s;
+        while (head < tail) {
+            const std::size_t first_new = tail;
+            view.for_each(order[head++], [&](id_type v){ if (seen.insert(v)) order[tail++] = v; });
+            if (rcm)
+                std::stable_sort(order.begin() + first_new, order.begin() + tail,
+                                 [&](id_type a, id_type b){ return view.degree(a) < view.degree(b); });
+        }
+    }
+    if (rcm) std::reverse(order.begin(), order.end());
+    return order;
+}
+
+// Copy of g with vertex order[i] renamed to id i. Rows are rebuilt sorted by the new target ids.
+// Throws std::invalid_argument if 'order' is not a permutation of g's ids.
+template <typename T>
+CSRGraph<T> permute(const CSRGraph<T>& g, const std::vector<typename CSRGraph<T>::id_type>& order) {
+    using id_type = typename CSRGraph<T>::id_type;
+    const std::size_t n = g.vertex_count();
+    if (order.size() != n) throw std::invalid_argument("permute: order has the wrong size");
+    std::vector<id_type> rank(n, CSRGraph<T>::npos); // old id -> new id
+    for (std::size_t i = 0; i < n; ++i) {
+        if (order[i] >= n || rank[order[i]] != CSRGraph<T>::npos) throw std::invalid_argument("permute: order is not a permutation");
+        rank[order[i]] = static_cast<id_type>(i);
+    }
+
+    VertexIndex<T> index;
+    index.reserve(n);
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        index.intern(g.vertex(order[i]));
+        offsets[i + 1] = offsets[i] + g.degree(order[i]);
+    }
+
+    std::vector<id_type> targets(g.arc_count());
+    std::vector<double> weights(g.arc_count());
+    parallel::for_chunks(n, parallel::thread_count(g.arc_count()), [&](std::size_t b, std::size_t e, std::size_t){
+        std::vector<std::pair<id_type, double>> row;
+        for (std::size_t i = b; i < e; ++i) {
+            const id_type old = order[i];
+            row.clear();
+            for (std::size_t a = g.arc_begin(old); a < g.arc_end(old); ++a) row.emplace_back(rank[g.target(a)], g.weight(a));
+            std::stable_sort(row.begin(), row.end(), [](const auto& x, const auto& y){ return x.first < y.first; });
+            std::size_t pos = offsets[i];
+            for (const auto& [v, w] : row) { targets[pos] = v; weights[pos] = w; ++pos; }
+        }
+    });
+    return CSRGraph<T>(g.is_directed(), std::move(index), Column<std::size_t>(std::move(offsets)),
+                       Column<id_type>(std::move(targets)), Column<double>(std::move(weights)));
+}
+
+template <typename T>
+CSRGraph<T> reorder(const CSRGraph<T>& g, VertexOrder how) {
+    if (how == VertexOrder::original) return g;
+    return permute(g, vertex_order(g, how));
+}
+
+}; // namespace Graph_implementation
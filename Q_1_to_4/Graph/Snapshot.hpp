@@ -0,0 +1,166 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "CSRGraph.hpp"
+#include "Column.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Binary graph snapshots: save_snapshot() writes a CSRGraph to a file, load_snapshot() maps
+ * it back without parsing or copying the arcs.
+ *
+ * Layout (native endianness, every section 8-byte aligned):
+ *   SnapshotHeader
+ *   labels   T[vertex_count]            id -> vertex label
+ *   offsets  uint64[vertex_count + 1]   CSR row starts
+ *   targets  uint32[arc_count]          arc -> target id (sorted within each row unless unsorted_flag)
+ *   weights  double[arc_count]          arc -> weight
+ *
+ * The loaded CSRGraph borrows offsets/targets/weights straight from the mapping (kept alive
+ * by the graph and its copies); only the vertex index is rebuilt from the label table, O(V),
+ * and one pass checks the row bounds and target ids so a damaged file cannot cause
+ * out-of-range reads.
+ * Labels must be trivially copyable (int vertices in this project).
+ */
+struct SnapshotHeader{
+    static constexpr char magic_bytes[8] = {'O','S','G','R','A','P','H','\0'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t directed_flag = 1;
+    static constexpr std::uint32_t unsorted_flag = 2; // rows written by from_edges(..., sort_rows = false)
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t label_size;       // sizeof(T) of the writer
+    std::uint32_t reserved;
+    std::uint64_t vertex_count;
+    std::uint64_t arc_count;
+    std::uint64_t labels_at;        // byte offsets of the sections from the start of the file
+    std::uint64_t offsets_at;
+    std::uint64_t targets_at;
+    std::uint64_t weights_at;
+    std::uint64_t file_size;
+};
+
+namespace snapshot_detail{
+
+inline std::uint64_t align8(std::uint64_t n) { return (n + 7) & ~std::uint64_t{7}; }
+
+// Fills in the section positions for n vertices / m arcs with labels of 'label_size' bytes.
+inline SnapshotHeader layout(std::uint64_t n, std::uint64_t m, std::uint32_t label_size) {
+    SnapshotHeader h{};
+    std::memcpy(h.magic, SnapshotHeader::magic_bytes, sizeof(h.magic));
+    h.version = SnapshotHeader::current_version;
+    h.label_size = label_size;
+    h.vertex_count = n;
+    h.arc_count = m;
+    h.labels_at = align8(sizeof(SnapshotHeader));
+    h.offsets_at = align8(h.labels_at + n * label_size);
+    h.targets_at = align8(h.offsets_at + (n + 1) * sizeof(std::uint64_t));
+    h.weights_at = align8(h.targets_at + m * sizeof(std::uint32_t));
+    h.file_size = h.weights_at + m * sizeof(double);
+    return h;
+}
+
+}; // namespace snapshot_detail
+
+template <typename T>
+void save_snapshot(const CSRGraph<T>& g, const std::string& path) {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots store vertex labels as raw bytes");
+    static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "CSR offsets are stored as uint64");
+
+    const std::uint64_t n = g.vertex_count(), m = g.arc_count();
+    SnapshotHeader h = snapshot_detail::layout(n, m, sizeof(T));
+    if (g.is_directed()) h.flags |= SnapshotHeader::directed_flag;
+    if (!g.rows_sorted()) h.flags |= SnapshotHeader::unsorted_flag;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("save_snapshot: cannot open " + path);
+    auto put = [&](std::uint64_t at, const void* data, std::size_t bytes) {
+        static const char zeros[8] = {};
+        const auto pos = static_cast<std::uint64_t>(out.tellp());
+        out.write(zeros, static_cast<std::streamsize>(at - pos)); // alignment padding
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    };
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    put(h.labels_at, g.vertex_index().vertices().data(), n * sizeof(T));
+    put(h.offsets_at, g.offsets().data(), (n + 1) * sizeof(std::uint64_t));
+    put(h.targets_at, g.targets().data(), m * sizeof(std::uint32_t));
+    put(h.weights_at, g.weights().data(), m * sizeof(double));
+    out.flush();
+    if (!out) throw std::runtime_error("save_snapshot: write failed for " + path);
+}
+
+// Maps 'path' read-only and returns a CSRGraph whose arc arrays live in the mapping.
+// Throws std::runtime_error if the file is missing, truncated or not a compatible snapshot.
+template <typename T>
+CSRGraph<T> load_snapshot(const std::string& path) {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots store vertex labels as raw bytes");
+    using id_type = typename CSRGraph<T>::id_type;
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("load_snapshot: cannot open " + path);
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        throw std::runtime_error("load_snapshot: not a graph snapshot: " + path);
+    }
+    const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+    void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping stays valid after close
+    if (base == MAP_FAILED) throw std::runtime_error("load_snapshot: mmap failed for " + path);
+    std::shared_ptr<const void> mapping(base, [bytes](const void* p){ ::munmap(const_cast<void*>(p), bytes); });
+
+    SnapshotHeader h;
+    std::memcpy(&h, base, sizeof(h));
+    const SnapshotHeader expect = snapshot_detail::layout(h.vertex_count, h.arc_count, sizeof(T));
+    if (std::memcmp(h.magic, SnapshotHeader::magic_bytes, sizeof(h.magic)) != 0)
+        throw std::runtime_error("load_snapshot: bad magic in " + path);
+    if (h.version != SnapshotHeader::current_version)
+        throw std::runtime_error("load_snapshot: unsupported version " + std::to_string(h.version));
+    if (h.label_size != sizeof(T) || h.vertex_count >= VertexIndex<T>::npos || h.arc_count > bytes
+        || h.labels_at != expect.labels_at || h.offsets_at != expect.offsets_at
+        || h.targets_at != expect.targets_at || h.weights_at != expect.weights_at
+        || h.file_size != expect.file_size || h.file_size != bytes)
+        throw std::runtime_error("load_snapshot: corrupt or incompatible header in " + path);
+
+    const char* at = static_cast<const char*>(base);
+    const std::size_t n = h.vertex_count, m = h.arc_count;
+    Column<std::size_t> offsets(reinterpret_cast<const std::size_t*>(at + h.offsets_at), n + 1, mapping);
+    Column<id_type> targets(reinterpret_cast<const id_type*>(at + h.targets_at), m, mapping);
+    Column<double> weights(reinterpret_cast<const double*>(at + h.weights_at), m, mapping);
+
+    // Row bounds must be monotone and targets in range so no algorithm can index past the arrays
+    if (offsets[0] != 0 || offsets[n] != m)
+        throw std::runtime_error("load_snapshot: corrupt offsets in " + path);
+    for (std::size_t u = 0; u < n; ++u)
+        if (offsets[u] > offsets[u + 1]) throw std::runtime_error("load_snapshot: corrupt offsets in " + path);
+    for (std::size_t a = 0; a < m; ++a)
+        if (targets[a] >= n) throw std::runtime_error("load_snapshot: corrupt targets in " + path);
+
+    VertexIndex<T> index;
+    index.reserve(n);
+    const T* labels = reinterpret_cast<const T*>(at + h.labels_at);
+    for (std::size_t i = 0; i < n; ++i)
+        if (index.intern(labels[i]) != i) throw std::runtime_error("load_snapshot: duplicate vertex label in " + path);
+
+    return CSRGraph<T>((h.flags & SnapshotHeader::directed_flag) != 0, std::move(index),
+                       std::move(offsets), std::move(targets), std::move(weights),
+                       (h.flags & SnapshotHeader::unsorted_flag) == 0);
+}
+
+}; // namespace Graph_implementation
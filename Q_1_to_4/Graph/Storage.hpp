@@ -0,0 +1,599 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+#include "VertexIndex.hpp"
+#include "Memory.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Adjacency storage backends for Graph<T, Storage>.
+ *
+ * A storage policy names the containers a Graph is made of:
+ *   row_type<T>         neighbor -> weight for one vertex
+ *   map_type<T, Row>    vertex   -> row
+ *   index_type<T>       the dense vertex-id interning (VertexIndex)
+ *   vector_type<X>      per-id counters
+ * row/map expose the small std::unordered_map subset Graph uses (find/end, try_emplace,
+ * operator[], at, count, erase, size/empty, reserve, iteration over (key, value) pairs).
+ *
+ *   HashStorage      std::unordered_map for both levels (node based, the original layout)
+ *   FlatHashStorage  open-addressing vertex table + SmallAdjacency rows
+ *   DenseStorage     vertex table indexed directly by the (integral) vertex value,
+ *                    for graphs whose vertices are 0..n-1 (init|n) + SmallAdjacency rows
+ *   CompactStorage<W> insertion-ordered vertex table (IndexedMap) + SmallAdjacency rows
+ *                    storing weights as W (float or int32_t, converted on insertion)
+ */
+
+// Iterator over occupied slots of a (slots, used-flags) table; shared by FlatMap and DenseMap.
+template <typename Slot, typename Flags>
+class SlotIterator{
+   public:
+    using value_type = std::remove_const_t<Slot>;
+    using reference = Slot&;
+    using pointer = Slot*;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    SlotIterator() = default;
+    SlotIterator(Slot* slots, Flags* used, std::size_t i, std::size_t cap)
+        : slots_(slots), used_(used), i_(i), cap_(cap) { skip_(); }
+
+    reference operator*() const { return slots_[i_]; }
+    pointer operator->() const { return &slots_[i_]; }
+    SlotIterator& operator++() { ++i_; skip_(); return *this; }
+    bool operator==(const SlotIterator& o) const { return i_ == o.i_; }
+    bool operator!=(const SlotIterator& o) const { return i_ != o.i_; }
+    std::size_t slot() const { return i_; }
+
+   private:
+    void skip_() { while (i_ < cap_ && !used_[i_]) ++i_; }
+    Slot* slots_ = nullptr;
+    Flags* used_ = nullptr;
+    std::size_t i_ = 0, cap_ = 0;
+};
+
+// Open-addressing hash map (linear probing, power-of-two capacity, backward-shift erase).
+// Keys and values live in one contiguous slot array, so lookups touch no extra nodes.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class FlatMap{
+   public:
+    using slot_type = std::pair<K, V>;
+    using iterator = SlotIterator<slot_type, const std::uint8_t>;
+    using const_iterator = SlotIterator<const slot_type, const std::uint8_t>;
+
+    iterator begin() { return iterator(slots_.data(), used_.data(), 0, slots_.size()); }
+    iterator end() { return iterator(slots_.data(), used_.data(), slots_.size(), slots_.size()); }
+    const_iterator begin() const { return const_iterator(slots_.data(), used_.data(), 0, slots_.size()); }
+    const_iterator end() const { return const_iterator(slots_.data(), used_.data(), slots_.size(), slots_.size()); }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void reserve(std::size_t n) {
+        std::size_t cap = 8;
+        while (cap * 7 < n * 10) cap <<= 1;
+        if (cap > slots_.size()) rehash_(cap);
+    }
+
+    iterator find(const K& k) {
+        const std::size_t i = locate_(k);
+        return i != npos_ ? iterator(slots_.data(), used_.data(), i, slots_.size()) : end();
+    }
+    const_iterator find(const K& k) const {
+        const std::size_t i = locate_(k);
+        return i != npos_ ? const_iterator(slots_.data(), used_.data(), i, slots_.size()) : end();
+    }
+    std::size_t count(const K& k) const { return locate_(k) != npos_ ? 1 : 0; }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& k, Args&&... args) {
+        if ((size_ + 1) * 10 > slots_.size() * 7) rehash_(slots_.empty() ? 8 : slots_.size() * 2);
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t i = home_(k, mask);
+        while (used_[i]) {
+            if (slots_[i].first == k) return {iterator(slots_.data(), used_.data(), i, slots_.size()), false};
+            i = (i + 1) & mask;
+        }
+        slots_[i] = slot_type(k, V(std::forward<Args>(args)...));
+        used_[i] = 1;
+        ++size_;
+        return {iterator(slots_.data(), used_.data(), i, slots_.size()), true};
+    }
+
+    V& operator[](const K& k) { return try_emplace(k).first->second; }
+
+    V& at(const K& k) {
+        const std::size_t i = locate_(k);
+        if (i == npos_) throw std::out_of_range("FlatMap::at");
+        return slots_[i].second;
+    }
+    const V& at(const K& k) const {
+        const std::size_t i = locate_(k);
+        if (i == npos_) throw std::out_of_range("FlatMap::at");
+        return slots_[i].second;
+    }
+
+    std::size_t erase(const K& k) {
+        std::size_t i = locate_(k);
+        if (i == npos_) return 0;
+        // Backward-shift deletion: pull later members of the probe run into the hole
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!used_[j]) break;
+            const std::size_t home = home_(slots_[j].first, mask);
+            // slot j may move to i only if its home is not cyclically inside (i, j]
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                slots_[i] = std::move(slots_[j]);
+                i = j;
+            }
+        }
+        slots_[i] = slot_type();
+        used_[i] = 0;
+        --size_;
+        return 1;
+    }
+
+    void clear() {
+        slots_.clear(); used_.clear(); size_ = 0;
+    }
+
+    std::size_t capacity() const { return slots_.size(); }
+
+    MemoryUsage memory_usage() const {
+        MemoryUsage m;
+        m.buckets = slots_.size();
+        m.bytes = slots_.capacity() * sizeof(slot_type) + used_.capacity();
+        for (std::size_t i = 0; i < slots_.size(); ++i)
+            if (used_[i]) m += memory::of(slots_[i]);
+        return m;
+    }
+
+   private:
+    static constexpr std::size_t npos_ = static_cast<std::size_t>(-1);
+
+    // std::hash<int> is the identity; mix the bits so strided keys don't share probe runs.
+    static std::size_t home_(const K& k, std::size_t mask) {
+        std::uint64_t h = static_cast<std::uint64_t>(Hash{}(k));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h) & mask;
+    }
+
+    std::size_t locate_(const K& k) const {
+        if (size_ == 0) return npos_;
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = home_(k, mask); used_[i]; i = (i + 1) & mask)
+            if (slots_[i].first == k) return i;
+        return npos_;
+    }
+
+    void rehash_(std::size_t cap) {
+        std::vector<slot_type> old_slots(cap);
+        std::vector<std::uint8_t> old_used(cap, 0);
+        old_slots.swap(slots_);
+        old_used.swap(used_);
+        size_ = 0;
+        const std::size_t mask = cap - 1;
+        for (std::size_t s = 0; s < old_slots.size(); ++s) {
+            if (!old_used[s]) continue;
+            std::size_t i = home_(old_slots[s].first, mask);
+            while (used_[i]) i = (i + 1) & mask;
+            slots_[i] = std::move(old_slots[s]);
+            used_[i] = 1;
+            ++size_;
+        }
+    }
+
+    std::vector<slot_type> slots_;
+    std::vector<std::uint8_t> used_;
+    std::size_t size_ = 0;
+};
+
+// Insertion-ordered hash map: entries live densely in one vector and the open-addressing
+// table only holds 32-bit entry positions, so a large value type (a whole adjacency row)
+// is not multiplied by the table's empty slots. Erase moves the last entry into the hole.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class IndexedMap{
+    static constexpr std::uint32_t empty_ = static_cast<std::uint32_t>(-1);
+
+   public:
+    using value_type = std::pair<K, V>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    iterator begin() { return entries_.data(); }
+    iterator end() { return entries_.data() + entries_.size(); }
+    const_iterator begin() const { return entries_.data(); }
+    const_iterator end() const { return entries_.data() + entries_.size(); }
+
+    std::size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    void reserve(std::size_t n) {
+        entries_.reserve(n);
+        std::size_t cap = 8;
+        while (cap * 7 < n * 10) cap <<= 1;
+        if (cap > table_.size()) rehash_(cap);
+    }
+
+    iterator find(const K& k) {
+        const std::size_t s = locate_(k);
+        return s != npos_ ? begin() + table_[s] : end();
+    }
+    const_iterator find(const K& k) const {
+        const std::size_t s = locate_(k);
+        return s != npos_ ? begin() + table_[s] : end();
+    }
+    std::size_t count(const K& k) const { return locate_(k) != npos_ ? 1 : 0; }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& k, Args&&... args) {
+        if ((entries_.size() + 1) * 10 > table_.size() * 7) rehash_(table_.empty() ? 8 : table_.size() * 2);
+        const std::size_t mask = table_.size() - 1;
+        std::size_t i = home_(k, mask);
+        for (; table_[i] != empty_; i = (i + 1) & mask)
+            if (entries_[table_[i]].first == k) return {begin() + table_[i], false};
+        table_[i] = static_cast<std::uint32_t>(entries_.size());
+        entries_.emplace_back(k, V(std::forward<Args>(args)...));
+        return {end() - 1, true};
+    }
+
+    V& operator[](const K& k) { return try_emplace(k).first->second; }
+
+    V& at(const K& k) {
+        const std::size_t s = locate_(k);
+        if (s == npos_) throw std::out_of_range("IndexedMap::at");
+        return entries_[table_[s]].second;
+    }
+    const V& at(const K& k) const {
+        const std::size_t s = locate_(k);
+        if (s == npos_) throw std::out_of_range("IndexedMap::at");
+        return entries_[table_[s]].second;
+    }
+
+    std::size_t erase(const K& k) {
+        std::size_t i = locate_(k);
+        if (i == npos_) return 0;
+        const std::uint32_t pos = table_[i];
+        // Backward-shift deletion in the table (same rule as FlatMap::erase)
+        const std::size_t mask = table_.size() - 1;
+        std::size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (table_[j] == empty_) break;
+            const std::size_t home = home_(entries_[table_[j]].first, mask);
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                table_[i] = table_[j];
+                i = j;
+            }
+        }
+        table_[i] = empty_;
+        // Fill the entry hole with the last entry and repoint its table slot
+        // (located before the move: a moved-from key may no longer compare equal)
+        if (pos + 1 != entries_.size()) {
+            const std::size_t s = locate_(entries_.back().first);
+            entries_[pos] = std::move(entries_.back());
+            table_[s] = pos;
+        }
+        entries_.pop_back();
+        return 1;
+    }
+
+    void clear() { entries_.clear(); table_.clear(); }
+
+    MemoryUsage memory_usage() const {
+        MemoryUsage m = memory::of(entries_);
+        m.buckets += table_.size();
+        m.bytes += table_.capacity() * sizeof(std::uint32_t);
+        return m;
+    }
+
+   private:
+    static constexpr std::size_t npos_ = static_cast<std::size_t>(-1);
+
+    static std::size_t home_(const K& k, std::size_t mask) {
+        std::uint64_t h = static_cast<std::uint64_t>(Hash{}(k));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h) & mask;
+    }
+
+    std::size_t locate_(const K& k) const {
+        if (entries_.empty()) return npos_;
+        const std::size_t mask = table_.size() - 1;
+        for (std::size_t i = home_(k, mask); table_[i] != empty_; i = (i + 1) & mask)
+            if (entries_[table_[i]].first == k) return i;
+        return npos_;
+    }
+
+    void rehash_(std::size_t cap) {
+        table_.assign(cap, empty_);
+        const std::size_t mask = cap - 1;
+        for (std::uint32_t e = 0; e < entries_.size(); ++e) {
+            std::size_t i = home_(entries_[e].first, mask);
+            while (table_[i] != empty_) i = (i + 1) & mask;
+            table_[i] = e;
+        }
+    }
+
+    std::vector<value_type> entries_;
+    std::vector<std::uint32_t> table_;
+};
+
+// Vertex table indexed by the vertex value itself (keys must be non-negative integers).
+template <typename K, typename V>
+class DenseMap{
+    static_assert(std::is_integral<K>::value, "DenseStorage needs integral vertex labels");
+   public:
+    using slot_type = std::pair<K, V>;
+    using iterator = SlotIterator<slot_type, const std::uint8_t>;
+    using const_iterator = SlotIterator<const slot_type, const std::uint8_t>;
+
+    iterator begin() { return iterator(slots_.data(), used_.data(), 0, slots_.size()); }
+    iterator end() { return iterator(slots_.data(), used_.data(), slots_.size(), slots_.size()); }
+    const_iterator begin() const { return const_iterator(slots_.data(), used_.data(), 0, slots_.size()); }
+    const_iterator end() const { return const_iterator(slots_.data(), used_.data(), slots_.size(), slots_.size()); }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    void reserve(std::size_t n) { slots_.reserve(n); used_.reserve(n); }
+
+    iterator find(const K& k) {
+        return has_(k) ? iterator(slots_.data(), used_.data(), slot_(k), slots_.size()) : end();
+    }
+    const_iterator find(const K& k) const {
+        return has_(k) ? const_iterator(slots_.data(), used_.data(), slot_(k), slots_.size()) : end();
+    }
+    std::size_t count(const K& k) const { return has_(k) ? 1 : 0; }
+    // False for a label try_emplace would reject
+    static bool accepts(const K& k) { return !negative_(k); }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& k, Args&&... args) {
+        if (negative_(k)) throw std::out_of_range("DenseMap: negative vertex label");
+        const std::size_t s = slot_(k);
+        if (s >= slots_.size()) { slots_.resize(s + 1); used_.resize(s + 1, 0); }
+        const bool inserted = !used_[s];
+        if (inserted) {
+            slots_[s] = slot_type(k, V(std::forward<Args>(args)...));
+            used_[s] = 1;
+            ++size_;
+        }
+        return {iterator(slots_.data(), used_.data(), s, slots_.size()), inserted};
+    }
+
+    V& operator[](const K& k) { return try_emplace(k).first->second; }
+
+    V& at(const K& k) {
+        if (!has_(k)) throw std::out_of_range("DenseMap::at");
+        return slots_[slot_(k)].second;
+    }
+    const V& at(const K& k) const {
+        if (!has_(k)) throw std::out_of_range("DenseMap::at");
+        return slots_[slot_(k)].second;
+    }
+
+    std::size_t erase(const K& k) {
+        if (!has_(k)) return 0;
+        slots_[slot_(k)] = slot_type();
+        used_[slot_(k)] = 0;
+        --size_;
+        return 1;
+    }
+
+    void clear() { slots_.clear(); used_.clear(); size_ = 0; }
+
+    MemoryUsage memory_usage() const {
+        MemoryUsage m;
+        m.buckets = slots_.size();
+        m.bytes = slots_.capacity() * sizeof(slot_type) + used_.capacity();
+        for (std::size_t i = 0; i < slots_.size(); ++i)
+            if (used_[i]) m += memory::of(slots_[i]);
+        return m;
+    }
+
+   private:
+    static bool negative_(const K& k) {
+        if constexpr (std::is_signed<K>::value) return k < 0;
+        else return false;
+    }
+    static std::size_t slot_(const K& k) { return static_cast<std::size_t>(k); }
+    bool has_(const K& k) const { return !negative_(k) && slot_(k) < slots_.size() && used_[slot_(k)]; }
+
+    std::vector<slot_type> slots_;
+    std::vector<std::uint8_t> used_;
+    std::size_t size_ = 0;
+};
+
+// Neighbor list with N entries stored inline (no allocation for low-degree vertices).
+// Lookups scan the list; once it grows past 'IndexAt' entries a FlatMap neighbor->position
+// index is kept alongside so find/try_emplace/erase stay O(1) on high-degree vertices.
+// W is the stored weight type (double by default; CompactStorage uses float or int32_t).
+template <typename T, std::size_t N = 4, typename W = double, std::size_t IndexAt = 16>
+class SmallAdjacency{
+    using position_index = FlatMap<T, std::uint32_t>;
+
+   public:
+    using value_type = std::pair<T, W>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+    static constexpr std::size_t index_threshold = IndexAt;
+
+    SmallAdjacency() = default;
+    SmallAdjacency(const SmallAdjacency& o) { *this = o; }
+    SmallAdjacency& operator=(const SmallAdjacency& o) {
+        if (this != &o) {
+            heap_ = o.heap_;
+            std::copy(o.inline_, o.inline_ + N, inline_);
+            size_ = o.size_;
+            spilled_ = o.spilled_;
+            pos_.reset(o.pos_ ? new position_index(*o.pos_) : nullptr);
+        }
+        return *this;
+    }
+    SmallAdjacency(SmallAdjacency&& o) noexcept { *this = std::move(o); }
+    SmallAdjacency& operator=(SmallAdjacency&& o) noexcept {
+        if (this != &o) {
+            heap_ = std::move(o.heap_);
+            std::move(o.inline_, o.inline_ + N, inline_);
+            size_ = o.size_;
+            spilled_ = o.spilled_;
+            pos_ = std::move(o.pos_);
+            o.heap_.clear(); o.size_ = 0; o.spilled_ = false;
+        }
+        return *this;
+    }
+
+    iterator begin() { return data_(); }
+    iterator end() { return data_() + size_; }
+    const_iterator begin() const { return data_(); }
+    const_iterator end() const { return data_() + size_; }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void reserve(std::size_t n) {
+        if (n > N) { spill_(); heap_.reserve(n); }
+    }
+
+    iterator find(const T& v) {
+        const std::size_t i = position_(v);
+        return i < size_ ? begin() + i : end();
+    }
+    const_iterator find(const T& v) const {
+        const std::size_t i = position_(v);
+        return i < size_ ? begin() + i : end();
+    }
+    std::size_t count(const T& v) const { return position_(v) < size_ ? 1 : 0; }
+
+    std::pair<iterator, bool> try_emplace(const T& v, double w) {
+        const std::size_t i = position_(v);
+        if (i < size_) return {begin() + i, false};
+        if (!spilled_ && size_ == N) spill_();
+        if (spilled_) heap_.emplace_back(v, static_cast<W>(w));
+        else inline_[size_] = value_type(v, static_cast<W>(w));
+        ++size_;
+        if (pos_) pos_->try_emplace(v, size_ - 1);
+        else if (size_ > index_threshold) build_index_();
+        return {end() - 1, true};
+    }
+
+    // Order is not preserved: the last entry moves into the erased slot.
+    std::size_t erase(const T& v) {
+        const std::size_t i = position_(v);
+        if (i >= size_) return 0;
+        value_type* d = data_();
+        if (pos_) pos_->erase(v);
+        if (i + 1 != size_) {
+            d[i] = std::move(d[size_ - 1]);
+            if (pos_) pos_->at(d[i].first) = static_cast<std::uint32_t>(i);
+        }
+        if (spilled_) heap_.pop_back();
+        --size_;
+        return 1;
+    }
+
+    MemoryUsage memory_usage() const {
+        MemoryUsage m = memory::of(heap_);
+        if (pos_) {
+            m.nodes += 1;
+            m.bytes += sizeof(position_index);
+            m += pos_->memory_usage();
+        }
+        return m;
+    }
+
+   private:
+    value_type* data_() { return spilled_ ? heap_.data() : inline_; }
+    const value_type* data_() const { return spilled_ ? heap_.data() : inline_; }
+
+    std::size_t position_(const T& v) const {
+        if (pos_) {
+            auto it = pos_->find(v);
+            return it != pos_->end() ? it->second : size_;
+        }
+        const value_type* d = data_();
+        for (std::size_t i = 0; i < size_; ++i) if (d[i].first == v) return i;
+        return size_;
+    }
+
+    void spill_() {
+        if (spilled_) return;
+        heap_.assign(inline_, inline_ + size_);
+        spilled_ = true;
+    }
+
+    void build_index_() {
+        pos_.reset(new position_index());
+        pos_->reserve(size_ * 2);
+        const value_type* d = data_();
+        for (std::uint32_t i = 0; i < size_; ++i) pos_->try_emplace(d[i].first, i);
+    }
+
+    value_type inline_[N]{};
+    std::vector<value_type> heap_;
+    std::uint32_t size_ = 0;
+    bool spilled_ = false;
+    std::unique_ptr<position_index> pos_; // only high-degree rows pay for the index
+};
+
+// ======================= Storage policies =======================
+struct HashStorage{
+    template <typename T> using row_type = std::unordered_map<T, double>;
+    template <typename T, typename Row> using map_type = std::unordered_map<T, Row>;
+    template <typename T> using index_type = VertexIndex<T>;
+    template <typename X> using vector_type = std::vector<X>;
+};
+
+struct FlatHashStorage{
+    template <typename T> using row_type = SmallAdjacency<T>;
+    template <typename T, typename Row> using map_type = FlatMap<T, Row>;
+    template <typename T> using index_type = VertexIndex<T>;
+    template <typename X> using vector_type = std::vector<X>;
+};
+
+struct DenseStorage{
+    template <typename T> using row_type = SmallAdjacency<T>;
+    template <typename T, typename Row> using map_type = DenseMap<T, Row>;
+    template <typename T> using index_type = VertexIndex<T>;
+    template <typename X> using vector_type = std::vector<X>;
+};
+
+// Smallest footprint: an int graph costs 8 bytes per arc (int id + 4-byte weight) instead of
+// a 32-byte hash node per arc, rows are indexed only past 64 neighbors, and the vertex
+// table keeps rows densely (IndexedMap). Weights are converted to W when stored.
+template <typename W = float>
+struct CompactStorage{
+    static_assert(sizeof(W) <= 4, "CompactStorage keeps 32-bit weights (float, int32_t)");
+    template <typename T> using row_type = SmallAdjacency<T, 2, W, 64>;
+    template <typename T, typename Row> using map_type = IndexedMap<T, Row>;
+    template <typename T> using index_type = VertexIndex<T>;
+    template <typename X> using vector_type = std::vector<X>;
+};
+
+// The HashStorage layout on std::pmr containers. Graph(n, directed, mr) puts the vertex table,
+// every adjacency row, the index and the counters on one memory_resource (e.g. a per-job
+// monotonic arena); rows created later inherit it through uses-allocator construction.
+struct PmrStorage{
+    template <typename T> using row_type = std::pmr::unordered_map<T, double>;
+    template <typename T, typename Row> using map_type = std::pmr::unordered_map<T, Row>;
+    template <typename T> using index_type = VertexIndex<T, std::pmr::vector<T>, std::pmr::unordered_map<T, std::uint32_t>>;
+    template <typename X> using vector_type = std::pmr::vector<X>;
+};
+
+}; // namespace Graph_implementation
@@ -0,0 +1,100 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+#include <memory_resource>
+
+#include "Memory.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * Disjoint sets over dense ids 0..n-1 (union by size, path halving).
+ * Graph keeps one per graph, updated on edge insertion, for O(α) connectivity queries;
+ * CSRGraph builds a temporary one for its weak-connectivity check.
+ * Ids is the per-id array type (std::vector by default, CowVector under CowStorage,
+ * std::pmr::vector under PmrStorage or for scratch sets on a job arena).
+ * The const find() does not compress paths, so a shared snapshot can be queried from
+ * several threads; union by size keeps those walks O(log n).
+ */
+template <typename Ids = std::vector<std::uint32_t>>
+class UnionFind{
+   public:
+    using id_type = std::uint32_t;
+
+    UnionFind() = default;
+    explicit UnionFind(std::size_t n) { reset(n); }
+    // Allocator-aware arrays (std::pmr::vector): allocate from 'mr', also when copying 'other'.
+    explicit UnionFind(std::pmr::memory_resource* mr) : parent_(mr), size_(mr) {}
+    UnionFind(std::size_t n, std::pmr::memory_resource* mr) : parent_(mr), size_(mr) { reset(n); }
+    UnionFind(const UnionFind& other, std::pmr::memory_resource* mr)
+        : parent_(other.parent_, mr), size_(other.size_, mr), sets_(other.sets_) {}
+    UnionFind(const UnionFind&) = default;
+    UnionFind(UnionFind&&) = default;
+    UnionFind& operator=(const UnionFind&) = default;
+    UnionFind& operator=(UnionFind&&) = default;
+
+    // n singleton sets
+    void reset(std::size_t n) {
+        parent_.clear();
+        size_.clear();
+        parent_.reserve(n);
+        size_.reserve(n);
+        sets_ = 0;
+        for (std::size_t i = 0; i < n; ++i) add();
+    }
+
+    // Adds a singleton set and returns its id (the next dense id).
+    id_type add() {
+        const id_type id = static_cast<id_type>(parent_.size());
+        parent_.push_back(id);
+        size_.push_back(1);
+        ++sets_;
+        return id;
+    }
+
+    id_type find(id_type x) {
+        while (parent_[x] != x) {
+            const id_type up = parent_[parent_[x]];
+            parent_[x] = up;
+            x = up;
+        }
+        return x;
+    }
+    id_type find(id_type x) const {
+        while (parent_[x] != x) x = parent_[x];
+        return x;
+    }
+
+    // Merges the sets of a and b; false if they were already together.
+    bool unite(id_type a, id_type b) {
+        a = find(a); b = find(b);
+        if (a == b) return false;
+        if (size_[a] < size_[b]) std::swap(a, b);
+        parent_[b] = a;
+        size_[a] += size_[b];
+        --sets_;
+        return true;
+    }
+
+    bool same(id_type a, id_type b) const { return find(a) == find(b); }
+    std::size_t set_size(id_type x) const { return size_[find(x)]; }
+
+    std::size_t size() const { return parent_.size(); }
+    std::size_t sets() const { return sets_; }
+
+    MemoryUsage memory_usage() const {
+        MemoryUsage m = memory::of(parent_);
+        m += memory::of(size_);
+        return m;
+    }
+
+   private:
+    Ids parent_;
+    Ids size_;
+    std::size_t sets_ = 0;
+};
+
+}; // namespace Graph_implementation
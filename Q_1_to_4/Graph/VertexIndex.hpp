@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+#include "Memory.hpp"
+#include "Arena.hpp"
+
+namespace Graph_implementation{
+
+/*
+ * VertexIndex<T> interns vertex labels into contiguous 32-bit ids 0..n-1
+ * (first-seen order). Algorithms translate a label once and then keep their
+ * visited/parent/cursor state in plain vectors and bitsets indexed by id.
+ * Labels/Ids are the id -> label and label -> id containers (std ones by default;
+ * CowStorage plugs in copy-on-write versions so copying an index is O(1)).
+ */
+template <typename T,
+          typename Labels = std::vector<T>,
+          typename Ids = std::unordered_map<T, std::uint32_t>>
+class VertexIndex{
+   public:
+    using id_type = std::uint32_t;
+    static constexpr id_type npos = std::numeric_limits<id_type>::max();
+
+    VertexIndex() = default;
+    // Allocator-aware tables (PmrStorage): both allocate from 'mr', also when copying 'other'.
+    explicit VertexIndex(std::pmr::memory_resource* mr) : labels_(mr), ids_(mr) {}
+    VertexIndex(const VertexIndex& other, std::pmr::memory_resource* mr) : labels_(other.labels_, mr), ids_(other.ids_, mr) {}
+
+    // Returns the id of v, assigning the next free id if v is new.
+    id_type intern(const T& v) {
+        auto [it, inserted] = ids_.try_emplace(v, static_cast<id_type>(labels_.size()));
+        if (inserted) labels_.push_back(v);
+        return it->second;
+    }
+
+    id_type id_of(const T& v) const {
+        auto it = ids_.find(v);
+        return it != ids_.end() ? it->second : npos;
+    }
+
+    bool contains(const T& v) const { return ids_.find(v) != ids_.end(); }
+    const T& vertex(id_type id) const { return labels_[id]; }
+    const Labels& vertices() const { return labels_; }
+    std::size_t size() const { return labels_.size(); }
+    bool empty() const { return labels_.empty(); }
+
+    void reserve(std::size_t n) { labels_.reserve(n); ids_.reserve(n); }
+
+    MemoryUsage memory_usage() const {
+        MemoryUsage m = memory::of(labels_);
+        m += memory::of(ids_);
+        return m;
+    }
+
+   private:
+    Labels labels_;   // id -> label
+    Ids ids_;         // label -> id
+};
+
+// Fixed-size bitset over dense ids (visited / in-tree / nonzero flags), on the scratch resource.
+class DenseBitset{
+   public:
+    DenseBitset() = default;
+    explicit DenseBitset(std::size_t n) : bits_(arena::scratch_array<std::uint64_t>((n + 63) / 64)), size_(n) {}
+
+    bool test(std::size_t i) const { return (bits_[i >> 6] >> (i & 63)) & 1u; }
+    void set(std::size_t i) { bits_[i >> 6] |= (std::uint64_t{1} << (i & 63)); }
+    void reset(std::size_t i) { bits_[i >> 6] &= ~(std::uint64_t{1} << (i & 63)); }
+
+    // Sets bit i and reports whether it was previously clear.
+    bool insert(std::size_t i) {
+        if (test(i)) return false;
+        set(i);
+        return true;
+    }
+
+    void clear() { std::fill(bits_.begin(), bits_.end(), 0); }
+    std::size_t size() const { return size_; }
+
+   private:
+    arena::scratch_vector<std::uint64_t> bits_;
+    std::size_t size_ = 0;
+};
+
+}; // namespace Graph_implementation
@@ -23,6 +23,11 @@
 #include <sstream>
 #include <string>
 #include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <cstdio>
+#include <memory_resource>
+#include <thread>
 
 using namespace Graph_implementation;
 
@@ -272,8 +277,53 @@ TEST_CASE("Basic: multiple add_edge calls to same neighbor do not create multi-e
     Graph<int> g(0,false);
     g.add_edge(1,2,1.0);
     g.add_edge(1,2,1.0);
-    g.add_edge(1,2,5.0); // different weight, but representation uses set of pairs -> only one (2,5.0) or (2,1.0) depending on insertion
+    g.add_edge(1,2,5.0); // different weight: neighbors are keyed by vertex, so the first weight (1.0) is kept
     CHECK(g.degree(1) == 1);
+    CHECK(g.degree(2) == 1);
+    auto mst = g.prims_algorithm(1);
+    REQUIRE(mst.size() == 1);
+    CHECK(mst[0].edge_weight == doctest::Approx(1.0));
+}
+
+TEST_CASE("Basic: remove_edge then re-add picks up the new weight") {
+    Graph<int> g(0,true);
+    g.add_edge(1,2,3.0);
+    g.remove_edge(1,2);
+    g.remove_edge(1,2); // absent edge is a no-op
+    CHECK(g.out_degree(1) == 0);
+    g.add_edge(1,2,7.0);
+    auto csr = g.freeze();
+    auto a = csr.find_arc(csr.id_of(1), csr.id_of(2));
+    REQUIRE(a < csr.arc_count());
+    CHECK(csr.weight(a) == doctest::Approx(7.0));
+}
+
+TEST_CASE("Basic: degree counters follow add/remove (directed, self-loops excluded from in-degree)") {
+    Graph<int> g(0,true);
+    g.add_edge(1,2,1.0);
+    g.add_edge(1,2,4.0); // duplicate: counters unchanged
+    g.add_edge(3,2,1.0);
+    g.add_edge(2,2,1.0); // self-loop: out-degree only
+    CHECK(g.in_degree(2) == 2);
+    CHECK(g.out_degree(2) == 1);
+    g.remove_edge(1,2);
+    g.remove_edge(1,2);
+    g.remove_edge(2,2);
+    CHECK(g.in_degree(2) == 1);
+    CHECK(g.out_degree(2) == 0);
+    CHECK(g.in_degree(42) == 0);
+
+    Graph<int> u(0,false);
+    u.add_edge(1,2,1.0);
+    u.add_edge(2,3,1.0);
+    u.add_edge(3,3,1.0);
+    CHECK(u.in_degree(2) == 2);
+    CHECK(u.in_degree(3) == 1);
+    u.remove_edge(3,2);
+    CHECK(u.in_degree(2) == 1);
+    CHECK(u.in_degree(3) == 0);
+    Graph<int> c(u);
+    CHECK(c.in_degree(1) == 1);
 }
 
 // ============================== Section: Eulerian ==============================
@@ -324,6 +374,30 @@ TEST_CASE("Euler (directed): non-weakly-connected over non-zero-degree subgraph
     CHECK(g.is_eulerian() == false);
 }
 
+TEST_CASE("Euler: unbalanced-vertex counter matches a full scan after random edits") {
+    for (bool directed : {false, true}) {
+        Graph<int> g(0, directed);
+        std::mt19937 rng(directed ? 11 : 12);
+        std::uniform_int_distribution<int> d(0, 29), op(0, 9);
+        auto scan = [&]{
+            size_t bad = 0;
+            for (int v = 0; v < 30; ++v) {
+                if (!g.vertex_index().contains(v)) continue;
+                bad += directed ? g.in_degree(v) != g.out_degree(v) : g.degree(v) % 2 != 0;
+            }
+            return bad;
+        };
+        for (int step = 0; step < 600; ++step) {
+            const int u = d(rng), v = d(rng), k = op(rng);
+            if (k < 5) g.add_edge(u, v, 1.0);
+            else if (k < 8) g.remove_edge(u, v);
+            else g.add_edges({{u, v, 1.0}, {v, d(rng), 1.0}, {u, u, 1.0}});
+            REQUIRE(g.unbalanced_vertices() == scan());
+        }
+        if (!directed) CHECK(g.all_even_degree() == (scan() == 0));
+    }
+}
+
 // ============================== Section: MST (Prim) & Arborescence ==============================
 
 TEST_CASE("MST (Prim): known small graph total weight") {
@@ -407,6 +481,22 @@ TEST_CASE("Arborescence: unreachable nodes from root => expect empty result") {
     CHECK(arb.empty());
 }
 
+TEST_CASE("MST: spanning_edges columns match prims_algorithm and the CSR snapshot") {
+    Graph<int> g = make_grid_graph<int>(6, 7, 1.0);
+    g.add_edge(0, 42, 0.25); // pendant vertex
+    WeightedEdgeList<int> cols = g.spanning_edges(0);
+    auto rows = g.prims_algorithm(0);
+    REQUIRE(cols.size() == rows.size());
+    CHECK(cols.size() == 42);
+    for (size_t i = 0; i < cols.size(); ++i) {
+        CHECK(cols.from(i) == rows[i].vertex_w);
+        CHECK(cols.to(i) == rows[i].vertex_r);
+        CHECK(cols[i].edge_weight == rows[i].edge_weight);
+    }
+    CHECK(cols.total_weight() == doctest::Approx(41.25));
+    CHECK(g.freeze().spanning_edges(0).total_weight() == doctest::Approx(41.25));
+}
+
 // ============================== Section: SCC / CC ==============================
 
 TEST_CASE("SCC: multiple strongly connected components with isolates") {
@@ -429,6 +519,63 @@ TEST_CASE("SCC: multiple strongly connected components with isolates") {
     CHECK(S == expected);
 }
 
+TEST_CASE("SCC: Tarjan finds Kosaraju's components in a topological order") {
+    for (uint32_t seed = 1; seed <= 10; ++seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> pick(0, 149);
+        std::vector<std::pair<int,int>> arcs;
+        Graph<int> g(0,true);
+        for (int v = 0; v < 150; ++v) g.add_vertex(v);
+        for (int i = 0; i < 220; ++i) {
+            const int u = pick(rng), v = pick(rng);
+            g.add_edge(u, v, 1.0);
+            arcs.emplace_back(u, v);
+        }
+        const auto tarjan = g.strongly_connected_components(SccEngine::tarjan);
+        CHECK(to_set_of_sets(tarjan) == to_set_of_sets(g.kosarajus_algorithm_scc()));
+        std::unordered_map<int, size_t> comp_of;
+        for (size_t c = 0; c < tarjan.size(); ++c) for (int v : tarjan[c]) comp_of[v] = c;
+        for (auto [u, v] : arcs) CHECK(comp_of[u] <= comp_of[v]); // arcs never point back to an earlier component
+    }
+    Graph<int> ring(0,true); // deep DFS: one 100k-vertex cycle
+    for (int v = 0; v < 100000; ++v) ring.add_edge(v, (v + 1) % 100000, 1.0);
+    CHECK(ring.strongly_connected_components(SccEngine::tarjan).size() == 1);
+
+    Graph<int> u = make_empty_graph<int>(false); // undirected: connected components whatever the engine
+    u.add_edge(0,1,1.0); u.add_edge(2,3,1.0);
+    CHECK(u.strongly_connected_components(SccEngine::tarjan).size() == 2);
+    CHECK(parse_scc_engine("tarjan") == SccEngine::tarjan);
+    CHECK(parse_scc_engine("kosaraju") == SccEngine::kosaraju);
+    CHECK_THROWS_AS(parse_scc_engine("pearce"), std::invalid_argument);
+}
+
+TEST_CASE("SCC: parallel engine returns Kosaraju's component sets for any thread count") {
+    for (uint32_t seed = 1; seed <= 8; ++seed) {
+        auto g = make_random_directed<int>(200, 1.5 / 200 * (1 + seed % 3), seed);
+        const auto expected = to_set_of_sets(g.kosarajus_algorithm_scc());
+        for (size_t threads : {1, 2, 3, 4})
+            CHECK(to_set_of_sets(g.strongly_connected_components(SccEngine::parallel, threads)) == expected);
+        CHECK(to_set_of_sets(g.freeze().strongly_connected_components(SccEngine::tarjan)) == expected);
+    }
+    // A giant cycle with tails and chains: forward-backward takes the cycle, trimming the tails,
+    // label propagation the two small cycles hanging off it
+    Graph<int> g(0,true);
+    for (int v = 0; v < 1000; ++v) g.add_edge(v, (v + 1) % 1000, 1.0);
+    for (int v = 1000; v < 1100; ++v) g.add_edge(v - 1, v, 1.0); // chain out of the cycle
+    g.add_edge(2000, 2001, 1.0); g.add_edge(2001, 2000, 1.0); g.add_edge(5, 2000, 1.0);
+    g.add_edge(3000, 3001, 1.0); g.add_edge(3001, 3002, 1.0); g.add_edge(3002, 3000, 1.0); g.add_edge(3000, 7, 1.0);
+    g.add_vertex(4000);
+    const auto expected = to_set_of_sets(g.kosarajus_algorithm_scc());
+    CHECK(expected.size() == 100 + 1 + 1 + 1 + 1);
+    for (size_t threads : {1, 3})
+        CHECK(to_set_of_sets(g.strongly_connected_components(SccEngine::parallel, threads)) == expected);
+
+    Graph<int> empty(0,true);
+    CHECK(empty.strongly_connected_components(SccEngine::parallel, 2).empty());
+    CHECK(parse_scc_engine("parallel") == SccEngine::parallel);
+    CHECK(parse_scc_engine("fb-trim") == SccEngine::parallel);
+}
+
 TEST_CASE("Connected Components (undirected): two components") {
     Graph<int> g = make_empty_graph<int>(false);
     for (int v=0; v<5; ++v) g.add_vertex(v);
@@ -449,7 +596,70 @@ TEST_CASE("Connected Components (undirected): two components") {
     CHECK(S == expected);
 }
 
-// ============================== Section: Max-Flow (Edmonds–Karp) ==============================
+TEST_CASE("Connected Components: union-find counts follow inserts, removals and bulk loads") {
+    Graph<int> g(0,false);
+    for (int v=0; v<6; ++v) g.add_vertex(v);
+    CHECK(g.component_count() == 6);
+    g.add_edge(0,1,1.0); g.add_edge(1,2,1.0); g.add_edge(2,0,1.0);
+    g.add_edge(3,4,1.0);
+    CHECK(g.component_count() == 3);
+    CHECK_FALSE(g.is_eulerian()); // 3-4 has odd degrees
+    g.remove_edge(3,4);           // components now stale: queries scan
+    CHECK(g.component_count() == 4);
+    CHECK(g.is_eulerian());       // isolated 3, 4, 5 are ignored
+    CHECK(to_set_of_sets(g.kosarajus_algorithm_scc()).size() == 4);
+    g.add_edge(5,5,1.0);          // rebuilds, then a self-loop touches 5 without merging
+    CHECK(g.component_count() == 4);
+    CHECK_FALSE(g.is_eulerian()); // 5 has an edge but is apart from the triangle
+    g.remove_edge(5,5);
+    CHECK(g.is_eulerian());
+
+    Graph<int> d(0,true);
+    d.add_edges({{0,1,1.0}, {1,0,1.0}, {2,3,1.0}, {3,2,1.0}, {3,3,1.0}});
+    CHECK(d.component_count() == 2);
+    d.remove_edge(0,1);           // 1->0 still joins them: no rebuild needed
+    CHECK(d.component_count() == 2);
+    d.add_edges({{1,2,1.0}});
+    CHECK(d.component_count() == 1);
+    d.add_edge(7,8,1.0);
+    CHECK(d.component_count() == 2);
+}
+
+TEST_CASE("Connected Components: Afforest matches the union-find grouping") {
+    for (uint32_t seed = 1; seed <= 6; ++seed) {
+        auto g = make_random_undirected<int>(300, 1.2 / 300 * seed, seed); // from many small pieces to one giant
+        const auto expected = g.kosarajus_algorithm_scc();
+        for (size_t threads : {1, 2, 4})
+            CHECK(g.strongly_connected_components(SccEngine::parallel, threads) == expected); // same order too
+        const auto snap = g.freeze();
+        CHECK(to_set_of_sets(snap.kosarajus_algorithm_scc()) == to_set_of_sets(expected));
+        const auto labels = snap.component_labels(3);
+        for (uint32_t v = 0; v < labels.size(); ++v) CHECK(labels[v] <= v); // named by the smallest id
+
+        // Removals make the union-find stale: the relabel goes through Afforest
+        std::vector<std::tuple<int,int,double>> kept;
+        std::vector<std::pair<int,int>> dropped;
+        for (uint32_t iu = 0; iu < snap.vertex_count(); ++iu)
+            for (size_t a = snap.arc_begin(iu); a < snap.arc_end(iu); ++a) {
+                const int u = snap.vertex(iu), v = snap.vertex(snap.target(a));
+                if (u > v) continue;
+                if ((u + v) % 3) kept.emplace_back(u, v, 1.0); else dropped.emplace_back(u, v);
+            }
+        Graph<int> fresh(0,false);
+        for (int v = 0; v < 300; ++v) fresh.add_vertex(v);
+        fresh.add_edges(kept);
+        for (auto [u, v] : dropped) g.remove_edge(u, v);
+        CHECK(to_set_of_sets(g.kosarajus_algorithm_scc()) == to_set_of_sets(fresh.kosarajus_algorithm_scc()));
+    }
+    // Directed snapshots get weak components: no giant-component skip without twin arcs
+    auto from_edges = CSRGraph<int>::from_edges({{0,1,1.0}, {2,1,1.0}, {3,4,1.0}, {5,5,1.0}}, true);
+    const auto weak = from_edges.component_labels(2);
+    CHECK(weak[from_edges.id_of(2)] == weak[from_edges.id_of(0)]);
+    CHECK(weak[from_edges.id_of(3)] != weak[from_edges.id_of(0)]);
+    CHECK(CSRGraph<int>::from_edges({}, false).component_labels().empty());
+}
+
+// ============================== Section: Max-Flow (Edmonds–Karp / Dinic / push–relabel) ==============================
 
 TEST_CASE("Max-Flow: classic small network") {
     // s=0 -> 1 (10), 0 -> 2 (5), 1 -> 2 (15), 1 -> 3 (10), 2 -> 4 (10), 3 -> 4 (10)
@@ -487,12 +697,234 @@ TEST_CASE("Max-Flow: negative capacities are ignored by residual (treated as non
     CHECK(g.edmon_karp_algorithm(0,2) == doctest::Approx(0.0));
 }
 
+TEST_CASE("Max-Flow: residual network pairs every arc with a reverse arc") {
+    Graph<int> g(0,true);
+    g.add_edge(0,1,4.0); g.add_edge(1,0,2.0); g.add_edge(1,2,3.0);
+    ResidualNetwork net = g.residual_network();
+    CHECK(net.vertex_count() == 3);
+    CHECK(net.arc_count() == 6);
+    for (size_t a = 0; a < net.arc_count(); ++a) {
+        CHECK(net.rev[net.rev[a]] == a);
+        CHECK(net.to[net.rev[a]] != net.to[a]);
+    }
+    CHECK(net.edmonds_karp(0, 2) == doctest::Approx(3.0));
+    double out_of_source = 0;
+    for (size_t a = net.offsets[0]; a < net.offsets[1]; ++a) out_of_source += net.flow[a];
+    CHECK(out_of_source == doctest::Approx(3.0));
+}
+
 TEST_CASE("Max-Flow: source/sink not in graph => flow 0") {
     Graph<int> g(0,true);
     g.add_edge(1,2,5.0);
     CHECK(g.edmon_karp_algorithm(99,100) == doctest::Approx(0.0));
 }
 
+TEST_CASE("Max-Flow: Dinic and push-relabel agree with Edmonds-Karp") {
+    for (uint32_t seed = 1; seed <= 12; ++seed) {
+        auto g = make_random_directed<int>(40, 0.12, seed, 1.0, 20.0);
+        const double ek = g.edmon_karp_algorithm(0, 39);
+        CHECK(g.max_flow(0, 39, FlowEngine::dinic) == doctest::Approx(ek));
+        CHECK(g.max_flow(0, 39, FlowEngine::push_relabel) == doctest::Approx(ek));
+        CHECK(g.max_flow(0, 39) == doctest::Approx(ek));
+        CHECK(g.freeze().max_flow(0, 39, FlowEngine::dinic) == doctest::Approx(ek));
+    }
+    const int layers = 5, width = 20;
+    Graph<int> lf(0, true);
+    lf.add_edges(generators::layered_flow<int>(layers, width, 4, 3, generators::uniform_int_weight{1, 9}));
+    const int sink = 1 + layers * width;
+    CHECK(lf.max_flow(0, sink, FlowEngine::dinic) == doctest::Approx(lf.edmon_karp_algorithm(0, sink)));
+    CHECK(lf.max_flow(0, sink, FlowEngine::push_relabel) == doctest::Approx(lf.edmon_karp_algorithm(0, sink)));
+    for (uint32_t seed = 1; seed <= 4; ++seed) { // dense, p ~ 0.3
+        auto d = make_random_directed<int>(60, 0.3, seed, 1.0, 50.0);
+        CHECK(d.max_flow(0, 59, FlowEngine::push_relabel) == doctest::Approx(d.edmon_karp_algorithm(0, 59)));
+        CHECK(d.freeze().max_flow(7, 3, FlowEngine::push_relabel) == doctest::Approx(d.edmon_karp_algorithm(7, 3)));
+    }
+
+    auto [g,s,t] = make_layered_flow<int>(3, 3, 7.0);
+    CHECK(g.max_flow(s, t, FlowEngine::dinic) == doctest::Approx(21.0));
+    CHECK(g.max_flow(s, s, FlowEngine::dinic) == doctest::Approx(0.0));
+    CHECK(g.max_flow(s, 12345, FlowEngine::dinic) == doctest::Approx(0.0));
+}
+
+TEST_CASE("Max-Flow: Dinic leaves a valid flow in the residual network") {
+    auto g = make_random_directed<int>(60, 0.1, 5, 1.0, 10.0);
+    ResidualNetwork net = g.residual_network();
+    const double value = net.dinic(0, 59);
+    std::vector<double> excess(net.vertex_count(), 0.0);
+    for (uint32_t u = 0; u < net.vertex_count(); ++u)
+        for (size_t a = net.offsets[u]; a < net.offsets[u+1]; ++a) {
+            CHECK(net.flow[a] <= net.cap[a] + 1e-9);
+            CHECK(net.flow[a] == doctest::Approx(-net.flow[net.rev[a]]));
+            excess[net.to[a]] += std::max(net.flow[a], 0.0);
+            excess[u] -= std::max(net.flow[a], 0.0);
+        }
+    for (uint32_t v = 1; v + 1 < net.vertex_count(); ++v) CHECK(excess[v] == doctest::Approx(0.0));
+    CHECK(excess[59] == doctest::Approx(value));
+}
+
+TEST_CASE("Max-Flow: every engine gives the same answers on the cases above") {
+    for (FlowEngine e : {FlowEngine::edmonds_karp, FlowEngine::dinic, FlowEngine::push_relabel, FlowEngine::parallel_push_relabel}) {
+        Graph<int> g(0,true);
+        for (int v=0; v<=4; ++v) g.add_vertex(v);
+        g.add_edge(0,1,10.0); g.add_edge(0,2,5.0); g.add_edge(1,2,15.0);
+        g.add_edge(1,3,10.0); g.add_edge(2,4,10.0); g.add_edge(3,4,10.0);
+        CHECK(g.max_flow(0,4,e) == doctest::Approx(15.0));
+        CHECK(g.max_flow(99,100,e) == doctest::Approx(0.0));
+
+        auto [lf,s,t] = make_layered_flow<int>(3, 3, 7.0);
+        CHECK(lf.max_flow(s,t,e) == doctest::Approx(21.0));
+
+        Graph<int> zero(0,true), neg(0,true);
+        zero.add_edge(0,1,0.0); zero.add_edge(1,2,0.0);
+        neg.add_edge(0,1,-5.0); neg.add_edge(1,2,-3.0);
+        CHECK(zero.max_flow(0,2,e) == doctest::Approx(0.0));
+        CHECK(neg.max_flow(0,2,e) == doctest::Approx(0.0));
+
+        Graph<int> pair(0,true);
+        pair.add_edge(0,1,4.0); pair.add_edge(1,0,2.0); pair.add_edge(1,2,3.0);
+        CHECK(pair.max_flow(0,2,e) == doctest::Approx(3.0));
+    }
+}
+
+TEST_CASE("Max-Flow: push-relabel leaves a preflow whose cut matches the value") {
+    auto g = make_random_directed<int>(80, 0.2, 9, 1.0, 10.0);
+    ResidualNetwork net = g.residual_network();
+    const double value = net.push_relabel(0, 79);
+    CHECK(value == doctest::Approx(g.edmon_karp_algorithm(0, 79)));
+    // Vertices still reaching the sink in the residual graph form the sink side of a min cut
+    std::vector<char> sink_side(net.vertex_count(), 0);
+    std::vector<uint32_t> q{79}; sink_side[79] = 1;
+    for (size_t head = 0; head < q.size(); ++head)
+        for (size_t b = net.offsets[q[head]]; b < net.offsets[q[head]+1]; ++b) {
+            const uint32_t w = net.to[b];
+            if (!sink_side[w] && net.residual(net.rev[b]) > 1e-12) { sink_side[w] = 1; q.push_back(w); }
+        }
+    CHECK(!sink_side[0]);
+    double cut = 0;
+    for (uint32_t u = 0; u < net.vertex_count(); ++u)
+        for (size_t a = net.offsets[u]; a < net.offsets[u+1]; ++a)
+            if (!sink_side[u] && sink_side[net.to[a]]) cut += net.cap[a];
+    CHECK(cut == doctest::Approx(value));
+}
+
+TEST_CASE("Max-Flow: parallel push-relabel agrees with Edmonds-Karp for any thread count") {
+    for (size_t threads : {1, 2, 3, 4}) {
+        for (uint32_t seed = 1; seed <= 6; ++seed) {
+            auto g = make_random_directed<int>(50, 0.15, seed, 1.0, 20.0);
+            CHECK(g.max_flow(0, 49, FlowEngine::parallel_push_relabel, threads) == doctest::Approx(g.edmon_karp_algorithm(0, 49)));
+        }
+        auto d = make_random_directed<int>(80, 0.3, 3, 1.0, 50.0);
+        CHECK(d.freeze().max_flow(5, 70, FlowEngine::parallel_push_relabel, threads) == doctest::Approx(d.edmon_karp_algorithm(5, 70)));
+
+        const int layers = 6, width = 25;
+        Graph<int> lf(0, true);
+        lf.add_edges(generators::layered_flow<int>(layers, width, 4, 11, generators::uniform_int_weight{1, 9}));
+        const int sink = 1 + layers * width;
+        CHECK(lf.max_flow(0, sink, FlowEngine::parallel_push_relabel, threads) == doctest::Approx(lf.edmon_karp_algorithm(0, sink)));
+
+        auto u = make_random_undirected<int>(60, 0.1, 8, 1.0, 10.0);
+        CHECK(u.max_flow(0, 59, FlowEngine::parallel_push_relabel, threads) == doctest::Approx(u.edmon_karp_algorithm(0, 59)));
+    }
+    // The preflow it leaves is as good as the sequential one: excess is never negative, capacities hold
+    auto g = make_random_directed<int>(70, 0.2, 13, 1.0, 10.0);
+    ResidualNetwork net = g.residual_network();
+    const double value = net.parallel_push_relabel(0, 69, 3);
+    CHECK(value == doctest::Approx(g.edmon_karp_algorithm(0, 69)));
+    std::vector<double> excess(net.vertex_count(), 0.0);
+    for (uint32_t v = 0; v < net.vertex_count(); ++v)
+        for (size_t a = net.offsets[v]; a < net.offsets[v+1]; ++a) {
+            CHECK(net.flow[a] <= net.cap[a] + 1e-9);
+            if (net.flow[a] > 0) { excess[net.to[a]] += net.flow[a]; excess[v] -= net.flow[a]; }
+        }
+    for (uint32_t v = 1; v < net.vertex_count(); ++v) CHECK(excess[v] >= -1e-9);
+    CHECK(excess[69] == doctest::Approx(value));
+}
+
+TEST_CASE("Max-Flow: engine names") {
+    CHECK(parse_flow_engine("dinic") == FlowEngine::dinic);
+    CHECK(parse_flow_engine("ek") == FlowEngine::edmonds_karp);
+    CHECK(parse_flow_engine("edmonds-karp") == FlowEngine::edmonds_karp);
+    CHECK(parse_flow_engine("pr") == FlowEngine::push_relabel);
+    CHECK(parse_flow_engine("push-relabel") == FlowEngine::push_relabel);
+    CHECK(parse_flow_engine("ppr") == FlowEngine::parallel_push_relabel);
+    CHECK(parse_flow_engine("parallel-push-relabel") == FlowEngine::parallel_push_relabel);
+    CHECK_THROWS_AS(parse_flow_engine("preflow"), std::invalid_argument);
+}
+
+TEST_CASE("FlowNetwork: many (s,t) queries on one network") {
+    auto g = make_random_directed<int>(50, 0.15, 31, 1.0, 10.0);
+    FlowNetwork<int> net(std::make_shared<const CSRGraph<int>>(g.freeze()));
+    for (int s = 0; s < 5; ++s)
+        for (int t = 45; t < 50; ++t) {
+            Graph<int> fresh(g); fresh.add_edge(1000, 1001, 1.0); // different version: no shared network
+            const double expected = fresh.max_flow(s, t, FlowEngine::dinic);
+            CHECK(net.max_flow(s, t) == doctest::Approx(expected));
+            CHECK(net.max_flow(s, t, FlowEngine::push_relabel) == doctest::Approx(expected));
+            CHECK(net.max_flow(s, t, FlowEngine::dinic) == doctest::Approx(expected));
+        }
+    CHECK(net.max_flow(0, 0) == doctest::Approx(0.0));
+    CHECK(net.max_flow(0, 777) == doctest::Approx(0.0));
+    net.reset();
+    for (size_t a = 0; a < net.residual().arc_count(); ++a) CHECK(net.residual().flow[a] == 0.0);
+}
+
+TEST_CASE("FlowNetwork: warm start after capacity changes") {
+    // two parallel routes 0->1->3 and 0->2->3, the first one narrow
+    Graph<int> g(0,true);
+    g.add_edge(0,1,10.0); g.add_edge(1,3,1.0); g.add_edge(0,2,2.0); g.add_edge(2,3,8.0);
+    auto net = g.flow_network();
+    CHECK(net->max_flow(0,3) == doctest::Approx(3.0));
+    CHECK(net->flow(1,3) == doctest::Approx(1.0));
+
+    CHECK(net->set_capacity(1,3,6.0));      // raise: the stored flow stays and is augmented
+    CHECK(net->capacity(1,3) == doctest::Approx(6.0));
+    CHECK(net->max_flow(0,3) == doctest::Approx(8.0));
+    CHECK(net->max_flow(0,3, FlowEngine::dinic) == doctest::Approx(8.0));
+
+    CHECK(net->set_capacity(0,2,0.5));      // below its flow: next query starts over
+    CHECK(net->max_flow(0,3) == doctest::Approx(6.5));
+    CHECK_FALSE(net->set_capacity(3,0,1.0)); // no such edge
+    CHECK(net->flow(3,0) == doctest::Approx(0.0));
+
+    Graph<int> u(0,false);
+    u.add_edge(0,1,1.0); u.add_edge(1,2,5.0);
+    auto un = u.flow_network();
+    CHECK(un->max_flow(2,0) == doctest::Approx(1.0));
+    un->set_capacity(1,0,4.0);              // undirected: both directions
+    CHECK(un->capacity(0,1) == doctest::Approx(4.0));
+    CHECK(un->max_flow(2,0) == doctest::Approx(4.0));
+}
+
+TEST_CASE("FlowNetwork: Graph reuses it per version and shares it with unchanged copies") {
+    auto g = make_random_directed<int>(30, 0.2, 4, 1.0, 10.0);
+    const double f = g.edmon_karp_algorithm(0, 29);
+    auto net = g.flow_network();
+    CHECK(g.flow_network() == net);
+    CHECK(g.max_flow(0, 29, FlowEngine::dinic) == doctest::Approx(f));
+    CHECK(g.max_flow(3, 29) == doctest::Approx(net->max_flow(3, 29)));
+
+    Graph<int> copy(g);
+    CHECK(copy.flow_network() == net);
+    copy.add_edge(0, 500, 100.0);         // the copy moves on, g keeps its network
+    copy.add_edge(500, 29, 100.0);
+    CHECK(copy.flow_network() != net);
+    CHECK(copy.edmon_karp_algorithm(0, 29) == doctest::Approx(f + 100.0));
+    CHECK(g.flow_network() == net);
+    CHECK(g.edmon_karp_algorithm(0, 29) == doctest::Approx(f));
+
+    Graph<int> other(g);
+    g.apply(GraphDelta<int>{}.insert(29, 0, 1.0).insert(29, 600, 1.0));
+    CHECK(other.flow_network() == net);
+    CHECK(g.flow_network() != net);
+
+    Graph<int> moved(std::move(other));   // the network travels with the move
+    CHECK(moved.flow_network() == net);
+    CHECK(other.flow_network() != net);   // the source starts over with its own cache
+    other = std::move(moved);
+    CHECK(other.flow_network() == net);
+    CHECK(moved.flow_network() != nullptr);
+}
+
 // ============================== Section: Hamiltonian Cycle ==============================
 
 TEST_CASE("Hamilton: simple cycle exists (undirected 4-cycle)") {
@@ -643,10 +1075,806 @@ TEST_CASE("Integration: run Max-Flow then check that output formatting still wor
     CHECK(s1.find("{") != std::string::npos);
 }
 
+// ============================== Section: CSR Snapshot (freeze) ==============================
+
+TEST_CASE("CSR: freeze keeps vertices, arcs and weights") {
+    Graph<int> g(0,false);
+    g.add_edge(0,1,2.0);
+    g.add_edge(1,2,3.0);
+    g.add_vertex(9);
+    auto csr = g.freeze();
+    CHECK(csr.vertex_count() == 4);
+    CHECK(csr.arc_count() == 4); // undirected edges are stored both ways
+    CHECK(csr.id_of(42) == CSRGraph<int>::npos);
+    auto a = csr.find_arc(csr.id_of(2), csr.id_of(1));
+    REQUIRE(a != csr.arc_count());
+    CHECK(csr.weight(a) == doctest::Approx(3.0));
+    CHECK(csr.degree(csr.id_of(9)) == 0);
+}
+
+TEST_CASE("CSR: algorithms agree with the Graph facade") {
+    auto und = make_random_undirected<int>(60, 0.08, 99);
+    auto ucsr = und.freeze();
+    CHECK(to_set_of_sets(ucsr.kosarajus_algorithm_scc()) == to_set_of_sets(und.kosarajus_algorithm_scc()));
+    double w1=0, w2=0;
+    for (auto& e : und.prims_algorithm(0)) w1 += e.edge_weight;
+    for (auto& e : ucsr.prims_algorithm(0)) w2 += e.edge_weight;
+    CHECK(w1 == doctest::Approx(w2));
+
+    auto dir = make_random_directed<int>(60, 0.05, 77);
+    auto dcsr = dir.freeze();
+    CHECK(to_set_of_sets(dcsr.kosarajus_algorithm_scc()) == to_set_of_sets(dir.kosarajus_algorithm_scc()));
+    CHECK(dcsr.edmon_karp_algorithm(0,59) == doctest::Approx(dir.edmon_karp_algorithm(0,59)));
+    CHECK(dcsr.prims_algorithm(0).size() == dir.prims_algorithm(0).size());
+
+    auto [fg,s,t] = make_layered_flow<int>(3, 4, 2.0);
+    CHECK(fg.freeze().edmon_karp_algorithm(s,t) == doctest::Approx(8.0));
+}
+
+TEST_CASE("CSR: Euler and Hamilton on frozen graphs") {
+    auto ring = make_cycle_graph<int>(7,false,1.0);
+    auto rc = ring.freeze();
+    CHECK(rc.is_eulerian());
+    auto circ = rc.euler_circuit();
+    CHECK(circ.size() == 8);
+    CHECK(circ.front() == circ.back());
+    auto ham = rc.hamilton_cycle(0);
+    CHECK(ham.size() == 8);
+
+    auto dc = make_directed_cycle<int>(5).freeze();
+    CHECK(dc.is_eulerian());
+    CHECK(dc.euler_circuit().size() == 6);
+
+    auto path = make_path_graph<int>(4,false,1.0).freeze();
+    CHECK(path.is_eulerian() == false);
+    CHECK(path.euler_circuit().empty());
+    CHECK(path.hamilton_cycle(0).empty());
+    CHECK(path.hamilton_cycle(77).empty());
+}
+
+TEST_CASE("CSR: from_edges matches add_edges + freeze (small and multi-threaded sizes)") {
+    std::vector<CSRGraph<int>::edge_tuple> small = {
+        {5,1,2.0}, {1,5,9.0}, {1,2,1.0}, {2,2,4.0}, {3,1,1.5}, {1,2,7.0}, {4,3,3.0}
+    };
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<int> d(0, 4999);
+    std::vector<CSRGraph<int>::edge_tuple> large;
+    for (int i = 0; i < 60000; ++i) large.emplace_back(d(rng), d(rng), 1.0 + (i % 5));
+
+    for (const auto* edges : {&small, &large}) {
+        for (bool directed : {false, true}) {
+            Graph<int> g(0, directed);
+            g.add_edges(*edges);
+            auto expect = g.freeze();
+            auto got = CSRGraph<int>::from_edges(*edges, directed);
+            REQUIRE(got.vertex_count() == expect.vertex_count());
+            REQUIRE(got.arc_count() == expect.arc_count());
+            CHECK(got.rows_sorted());
+            std::size_t mismatches = 0;
+            for (std::size_t i = 0; i < got.vertex_count(); ++i) {
+                auto id = static_cast<CSRGraph<int>::id_type>(i);
+                if (got.vertex(id) != expect.vertex(id) || got.arc_begin(id) != expect.arc_begin(id)) ++mismatches;
+            }
+            for (std::size_t a = 0; a < got.arc_count(); ++a)
+                if (got.target(a) != expect.target(a) || got.weight(a) != expect.weight(a)) ++mismatches;
+            CHECK(mismatches == 0);
+        }
+    }
+    CHECK(CSRGraph<int>::from_edges({}, false).vertex_count() == 0);
+}
+
+TEST_CASE("CSR: from_edges without row sorting keeps every arc and still answers lookups") {
+    std::vector<CSRGraph<int>::edge_tuple> ring;
+    for (int i = 0; i < 7; ++i) ring.emplace_back((i * 3) % 7, (i * 3 + 3) % 7, 1.0 + i);
+    auto csr = CSRGraph<int>::from_edges(ring, false, false);
+    CHECK_FALSE(csr.rows_sorted());
+    CHECK(csr.arc_count() == 14); // undirected edges are stored both ways
+    for (const auto& [u, v, w] : ring) {
+        auto a = csr.find_arc(csr.id_of(v), csr.id_of(u));
+        REQUIRE(a != csr.arc_count());
+        CHECK(csr.weight(a) == doctest::Approx(w));
+    }
+    CHECK_FALSE(csr.has_arc(csr.id_of(0), csr.id_of(1)));
+    CHECK(csr.is_eulerian());
+    CHECK(csr.euler_circuit().size() == 8);
+    ring.emplace_back(2, 2, 0.5);
+    CHECK(CSRGraph<int>::from_edges(ring, false, false).arc_count() == 15); // an undirected self-loop is one arc
+
+    const std::string path = "snapshot_unsorted.osg";
+    save_snapshot(csr, path);
+    auto loaded = load_snapshot<int>(path);
+    CHECK_FALSE(loaded.rows_sorted());
+    CHECK(loaded.has_arc(loaded.id_of(3), loaded.id_of(0)));
+    std::remove(path.c_str());
+}
+
+// Largest |id(u) - id(v)| over all arcs
+static std::size_t csr_bandwidth(const CSRGraph<int>& g) {
+    std::size_t bw = 0;
+    for (std::size_t u = 0; u < g.vertex_count(); ++u)
+        for (std::size_t a = g.arc_begin(u); a < g.arc_end(u); ++a) {
+            const std::size_t v = g.target(a);
+            bw = std::max(bw, u > v ? u - v : v - u);
+        }
+    return bw;
+}
+
+// (label u, label v, weight) of every arc
+static std::set<std::tuple<int,int,double>> labelled_arcs(const CSRGraph<int>& g) {
+    std::set<std::tuple<int,int,double>> arcs;
+    for (std::size_t u = 0; u < g.vertex_count(); ++u) {
+        auto id = static_cast<CSRGraph<int>::id_type>(u);
+        for (std::size_t a = g.arc_begin(id); a < g.arc_end(id); ++a)
+            arcs.emplace(g.vertex(id), g.vertex(g.target(a)), g.weight(a));
+    }
+    return arcs;
+}
+
+TEST_CASE("Reorder: every order keeps the labelled graph and the algorithm results") {
+    for (bool directed : {false, true}) {
+        Graph<int> g = directed ? make_random_directed<int>(120, 0.04, 12) : make_random_undirected<int>(120, 0.04, 12);
+        auto base = g.freeze();
+        for (VertexOrder how : {VertexOrder::original, VertexOrder::degree, VertexOrder::bfs, VertexOrder::rcm}) {
+            auto order = vertex_order(base, how);
+            std::vector<CSRGraph<int>::id_type> sorted(order);
+            std::sort(sorted.begin(), sorted.end());
+            for (std::size_t i = 0; i < sorted.size(); ++i) REQUIRE(sorted[i] == i);
+
+            auto r = g.freeze(how);
+            CHECK(r.rows_sorted());
+            CHECK(labelled_arcs(r) == labelled_arcs(base));
+            CHECK(to_set_of_sets(r.kosarajus_algorithm_scc()) == to_set_of_sets(base.kosarajus_algorithm_scc()));
+            CHECK(r.edmon_karp_algorithm(0, 7) == doctest::Approx(base.edmon_karp_algorithm(0, 7)));
+            CHECK(r.is_eulerian() == base.is_eulerian());
+            if (!directed) {
+                double w1 = 0, w2 = 0;
+                for (auto& e : r.prims_algorithm(3)) w1 += e.edge_weight;
+                for (auto& e : base.prims_algorithm(3)) w2 += e.edge_weight;
+                CHECK(w1 == doctest::Approx(w2));
+            }
+            if (how == VertexOrder::degree && !directed) // directed graphs sort by in + out degree
+                for (std::size_t i = 1; i < r.vertex_count(); ++i)
+                    CHECK(r.degree(static_cast<CSRGraph<int>::id_type>(i - 1)) >= r.degree(static_cast<CSRGraph<int>::id_type>(i)));
+        }
+    }
+}
+
+TEST_CASE("Reorder: RCM shrinks the bandwidth of a scrambled grid; bad permutations are rejected") {
+    const int side = 30;
+    std::vector<int> label(side * side);
+    std::iota(label.begin(), label.end(), 0);
+    std::shuffle(label.begin(), label.end(), std::mt19937(4));
+    auto edges = generators::grid<int>(side, side, 1);
+    for (auto& [u, v, w] : edges) { u = label[u]; v = label[v]; }
+    std::shuffle(edges.begin(), edges.end(), std::mt19937(5));
+    Graph<int> g(0, false);
+    g.add_edges(edges);
+
+    auto scrambled = g.freeze();
+    auto rcm = g.freeze(VertexOrder::rcm);
+    INFO("bandwidth scrambled=" << csr_bandwidth(scrambled) << " rcm=" << csr_bandwidth(rcm));
+    CHECK(csr_bandwidth(scrambled) > 10 * side);
+    CHECK(csr_bandwidth(rcm) <= 2 * side);
+    CHECK(labelled_arcs(rcm) == labelled_arcs(scrambled));
+
+    std::vector<CSRGraph<int>::id_type> bad(scrambled.vertex_count(), 0);
+    CHECK_THROWS_AS(permute(scrambled, bad), std::invalid_argument);
+    bad.pop_back();
+    CHECK_THROWS_AS(permute(scrambled, bad), std::invalid_argument);
+}
+
+// ============================== Section: Binary Snapshots ==============================
+
+TEST_CASE("Snapshot: save/load round trip keeps structure and algorithm results") {
+    const std::string path = "snapshot_roundtrip.osg";
+    for (bool directed : {false, true}) {
+        Graph<int> g = directed ? make_random_directed<int>(300, 0.02, 4) : make_random_undirected<int>(300, 0.02, 4);
+        g.add_edge(-7, 1000, 2.5); // labels need not be 0..n-1
+        const CSRGraph<int> frozen = g.freeze();
+        save_snapshot(frozen, path);
+        CSRGraph<int> loaded = load_snapshot<int>(path);
+
+        CHECK(loaded.is_directed() == directed);
+        REQUIRE(loaded.vertex_count() == frozen.vertex_count());
+        REQUIRE(loaded.arc_count() == frozen.arc_count());
+        CHECK(loaded.targets().borrowed());
+        CHECK(loaded.memory_usage().bytes < frozen.memory_usage().bytes);
+        CHECK(std::equal(loaded.offsets().begin(), loaded.offsets().end(), frozen.offsets().begin()));
+        CHECK(std::equal(loaded.targets().begin(), loaded.targets().end(), frozen.targets().begin()));
+        CHECK(std::equal(loaded.weights().begin(), loaded.weights().end(), frozen.weights().begin()));
+        CHECK(loaded.id_of(1000) == frozen.id_of(1000));
+        CHECK(to_set_of_sets(loaded.kosarajus_algorithm_scc()) == to_set_of_sets(g.kosarajus_algorithm_scc()));
+        CHECK(loaded.edmon_karp_algorithm(0, 1) == doctest::Approx(g.edmon_karp_algorithm(0, 1)));
+
+        // Copies share the mapping, which outlives the original graph object
+        CSRGraph<int> copy = loaded;
+        loaded = CSRGraph<int>();
+        CHECK(copy.arc_count() == frozen.arc_count());
+        CHECK(copy.weight(copy.arc_begin(copy.id_of(-7))) == 2.5);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Snapshot: missing, truncated and foreign files are rejected") {
+    const std::string path = "snapshot_bad.osg";
+    CHECK_THROWS_AS(load_snapshot<int>("no_such_snapshot.osg"), std::runtime_error);
+
+    Graph<int> g = make_cycle_graph<int>(50, true, 1.0);
+    save_snapshot(g.freeze(), path);
+    CHECK_THROWS_AS(load_snapshot<long long>(path), std::runtime_error); // label size mismatch
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() - 8);
+    }
+    CHECK_THROWS_AS(load_snapshot<int>(path), std::runtime_error);
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "edge|0|1|1\nedge|1|2|1\n......................................................................";
+    CHECK_THROWS_AS(load_snapshot<int>(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+// ============================== Section: Vertex Index ==============================
+
+TEST_CASE("VertexIndex: ids are dense, stable and shared with freeze()") {
+    Graph<int> g(false);
+    g.add_edge(40, 10, 1.0);
+    g.add_vertex(99);
+    g.add_edge(10, 25, 2.0);
+    g.add_edge(40, 10, 3.0); // existing edge, no new ids
+
+    const auto& idx = g.vertex_index();
+    REQUIRE(idx.size() == 4);
+    CHECK(idx.id_of(40) == 0);
+    CHECK(idx.id_of(10) == 1);
+    CHECK(idx.id_of(99) == 2);
+    CHECK(idx.id_of(25) == 3);
+    CHECK(idx.vertex(3) == 25);
+    CHECK(idx.id_of(7) == VertexIndex<int>::npos);
+
+    auto csr = g.freeze();
+    for (std::size_t id = 0; id < idx.size(); ++id)
+        CHECK(csr.id_of(idx.vertex(static_cast<VertexIndex<int>::id_type>(id))) == id);
+
+    Graph<int> copy(g);
+    CHECK(copy.vertex_index().id_of(25) == 3);
+}
+
+TEST_CASE("DenseBitset: insert reports first visit") {
+    DenseBitset bits(130);
+    CHECK(bits.insert(129));
+    CHECK_FALSE(bits.insert(129));
+    CHECK(bits.test(129));
+    bits.reset(129);
+    CHECK_FALSE(bits.test(129));
+    bits.set(64);
+    bits.clear();
+    CHECK_FALSE(bits.test(64));
+}
+
+// ============================== Section: Bulk Ingest (add_edges) ==============================
+
+// Same ids, same arcs with the same weights, same in-degrees.
+static void check_same_graph(const Graph<int>& a, const Graph<int>& b) {
+    auto ca = a.freeze(), cb = b.freeze();
+    REQUIRE(ca.vertex_count() == cb.vertex_count());
+    REQUIRE(ca.arc_count() == cb.arc_count());
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < ca.vertex_count(); ++i) {
+        auto id = static_cast<VertexIndex<int>::id_type>(i);
+        if (ca.vertex(id) != cb.vertex(id)) ++mismatches;
+        if (a.in_degree(ca.vertex(id)) != b.in_degree(cb.vertex(id))) ++mismatches;
+    }
+    for (std::size_t k = 0; k < ca.arc_count(); ++k)
+        if (ca.target(k) != cb.target(k) || ca.weight(k) != cb.weight(k)) ++mismatches;
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("Bulk: add_edges matches repeated add_edge (duplicates, reversed pairs, self-loops)") {
+    std::vector<Graph<int>::edge_tuple> edges = {
+        {5,1,2.0}, {1,5,9.0}, {1,2,1.0}, {2,2,4.0}, {3,1,1.5}, {1,2,7.0}, {4,3,3.0}
+    };
+    for (bool directed : {false, true}) {
+        Graph<int> seq(0, directed), bulk(0, directed);
+        for (const auto& [u,v,w] : edges) seq.add_edge(u, v, w);
+        bulk.add_edges(edges);
+        check_same_graph(seq, bulk);
+        CHECK(bulk.get_first() == 5);
+    }
+}
+
+TEST_CASE("Bulk: add_edges on a non-empty graph keeps existing weights") {
+    Graph<int> seq(0,false), bulk(0,false);
+    seq.add_edge(0,1,1.0);  bulk.add_edge(0,1,1.0);
+    std::vector<Graph<int>::edge_tuple> more = {{1,0,5.0}, {1,2,2.0}};
+    for (const auto& [u,v,w] : more) seq.add_edge(u, v, w);
+    bulk.add_edges(more);
+    bulk.add_edges({});
+    check_same_graph(seq, bulk);
+}
+
+TEST_CASE("Bulk: large batch takes the multi-threaded path") {
+    const int N = 3000;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> d(0, N-1);
+    std::vector<Graph<int>::edge_tuple> edges;
+    for (int i = 0; i < 40000; ++i) edges.emplace_back(d(rng), d(rng), 1.0 + (i % 7));
+    for (bool directed : {false, true}) {
+        Graph<int> seq(0, directed), bulk(0, directed);
+        for (const auto& [u,v,w] : edges) seq.add_edge(u, v, w);
+        bulk.add_edges(edges);
+        check_same_graph(seq, bulk);
+    }
+}
+
+// ============================== Section: Generators ==============================
+
+// No self-loops, no repeated pairs, labels in range, undirected pairs as (u < v).
+static bool simple_edge_list(const std::vector<Graph<int>::edge_tuple>& edges, int n, bool directed) {
+    std::set<std::pair<int,int>> seen;
+    for (const auto& [u, v, w] : edges) {
+        (void)w;
+        if (u < 0 || v < 0 || u >= n || v >= n || u == v) return false;
+        if (!directed && u > v) return false;
+        if (!seen.insert({u, v}).second) return false;
+    }
+    return true;
+}
+
+TEST_CASE("Generators: G(n,p) is seeded, simple and close to the expected size") {
+    for (bool directed : {false, true}) {
+        const int n = 2000;
+        const double p = 0.01;
+        auto a = generators::gnp<int>(n, p, directed, 7);
+        auto b = generators::gnp<int>(n, p, directed, 7);
+        CHECK(a == b);
+        CHECK(a != generators::gnp<int>(n, p, directed, 8));
+        CHECK(simple_edge_list(a, n, directed));
+        const double pairs = directed ? double(n) * (n - 1) : double(n) * (n - 1) / 2;
+        const double sigma = std::sqrt(pairs * p * (1 - p));
+        CHECK(std::abs(double(a.size()) - pairs * p) < 5 * sigma);
+    }
+    CHECK(generators::gnp<int>(6, 1.0, false, 1).size() == 15);
+    CHECK(generators::gnp<int>(6, 1.0, true, 1).size() == 30);
+    CHECK(generators::gnp<int>(6, 0.0, true, 1).empty());
+    CHECK(generators::gnp<int>(1, 1.0, true, 1).empty());
+
+    auto w = generators::gnp<int>(300, 0.05, false, 3, generators::uniform_int_weight{2, 4});
+    CHECK(std::all_of(w.begin(), w.end(), [](const auto& e){
+        const double x = std::get<2>(e);
+        return x == 2.0 || x == 3.0 || x == 4.0;
+    }));
+}
+
+TEST_CASE("Generators: G(n,m) gives exactly m distinct pairs, sparse or dense") {
+    for (bool directed : {false, true}) {
+        auto sparse = generators::gnm<int>(5000, 20000, directed, 11);
+        CHECK(sparse.size() == 20000);
+        CHECK(simple_edge_list(sparse, 5000, directed));
+        CHECK(sparse == generators::gnm<int>(5000, 20000, directed, 11));
+
+        const std::size_t pairs = directed ? 40 * 39 : 40 * 39 / 2;
+        auto dense = generators::gnm<int>(40, pairs - 3, directed, 5); // sampled through the complement
+        CHECK(dense.size() == pairs - 3);
+        CHECK(simple_edge_list(dense, 40, directed));
+        CHECK(generators::gnm<int>(40, pairs + 10, directed, 5).size() == pairs);
+    }
+    Graph<int> g(0, false);
+    g.add_edges(generators::gnm<int>(100, 300, false, 2));
+    CHECK(g.freeze().arc_count() == 600);
+}
+
+TEST_CASE("Generators: R-MAT is skewed, Barabási–Albert and grid have their exact shapes") {
+    auto r = generators::rmat<int>(12, 40000, false, 17, generators::exponential_weight{2.0});
+    CHECK(simple_edge_list(r, 1 << 12, false));
+    CHECK(r == generators::rmat<int>(12, 40000, false, 17, generators::exponential_weight{2.0}));
+    CHECK(r.size() > 20000);
+    Graph<int> rg(0, false);
+    rg.add_edges(r);
+    auto rc = rg.freeze();
+    std::size_t max_deg = 0;
+    for (std::size_t u = 0; u < rc.vertex_count(); ++u)
+        max_deg = std::max(max_deg, rc.degree(static_cast<CSRGraph<int>::id_type>(u)));
+    CHECK(max_deg > 20 * rc.arc_count() / rc.vertex_count()); // hubs far above the mean degree
+
+    const int n = 3000, k = 3;
+    auto ba = generators::barabasi_albert<int>(n, k, 5, generators::pareto_weight{1.0, 2.5});
+    CHECK(ba.size() == std::size_t(k * (k + 1) / 2 + (n - k - 1) * k));
+    CHECK(simple_edge_list(ba, n, false));
+    CHECK(std::all_of(ba.begin(), ba.end(), [](const auto& e){ return std::get<2>(e) >= 1.0; }));
+    Graph<int> bg(0, false);
+    bg.add_edges(ba);
+    CHECK(bg.component_count() == 1);
+    std::size_t hub = 0;
+    for (int v = 0; v < n; ++v) {
+        CHECK(bg.degree(v) >= std::size_t(k));
+        hub = std::max(hub, bg.degree(v));
+    }
+    CHECK(hub > 10 * k);
+
+    auto full = generators::grid<int>(7, 9, 1);
+    CHECK(full.size() == std::size_t(7 * 8 + 9 * 6));
+    CHECK(simple_edge_list(full, 63, false));
+    auto sparse = generators::grid<int>(30, 30, 1, generators::constant_weight{}, 0.5);
+    CHECK(sparse.size() < std::size_t(2 * 30 * 29));
+    CHECK(sparse.size() > std::size_t(30 * 29 / 2));
+}
+
+TEST_CASE("Generators: layered_flow builds an s-t network with the documented ids") {
+    const int layers = 4, width = 6, fanout = 2;
+    auto edges = generators::layered_flow<int>(layers, width, fanout, 9, generators::constant_weight{3.0});
+    CHECK(edges.size() == std::size_t(2 * width + (layers - 1) * width * fanout));
+    CHECK(simple_edge_list(edges, 2 + layers * width, true));
+    Graph<int> g(0, true);
+    g.add_edges(edges);
+    const int sink = 1 + layers * width;
+    CHECK(g.out_degree(0) == std::size_t(width));
+    CHECK(g.in_degree(sink) == std::size_t(width));
+    const double flow = g.edmon_karp_algorithm(0, sink);
+    CHECK(flow > 0.0);
+    CHECK(flow <= 3.0 * width);
+    CHECK(generators::layered_flow<int>(2, width, width + 5, 1).size() == std::size_t(2 * width + width * width)); // fanout capped at width
+}
+
+// ============================== Section: Storage Policies ==============================
+
+TEST_CASE("Storage: FlatMap insert, lookup, erase with probe-run repair") {
+    FlatMap<int,int> m;
+    for (int i = 0; i < 1000; ++i) CHECK(m.try_emplace(i * 64, i).second);
+    CHECK_FALSE(m.try_emplace(64, -1).second);
+    CHECK(m.size() == 1000);
+    for (int i = 0; i < 1000; i += 2) CHECK(m.erase(i * 64) == 1);
+    CHECK(m.erase(12345) == 0);
+    CHECK(m.size() == 500);
+    size_t found = 0;
+    for (int i = 0; i < 1000; ++i) found += m.count(i * 64);
+    CHECK(found == 500);
+    CHECK(m.at(64) == 1);
+    CHECK_THROWS_AS(m.at(0), std::out_of_range);
+    size_t walked = 0;
+    for (const auto& [k, v] : m) { CHECK(k == v * 64); ++walked; }
+    CHECK(walked == 500);
+}
+
+TEST_CASE("Storage: IndexedMap keeps insertion order and repairs positions on erase") {
+    IndexedMap<int,int> m;
+    for (int i = 0; i < 1000; ++i) CHECK(m.try_emplace(i * 64, i).second);
+    CHECK_FALSE(m.try_emplace(64, -1).second);
+    CHECK(m.begin()->first == 0);
+    for (int i = 0; i < 1000; i += 2) CHECK(m.erase(i * 64) == 1);
+    CHECK(m.erase(12345) == 0);
+    CHECK(m.size() == 500);
+    size_t found = 0;
+    for (int i = 0; i < 1000; ++i) found += m.count(i * 64);
+    CHECK(found == 500);
+    CHECK(m.at(64 * 999) == 999);
+    CHECK_THROWS_AS(m.at(0), std::out_of_range);
+    for (const auto& [k, v] : m) CHECK(k == v * 64);
+
+    // Keys that are emptied by a move: the hole is refilled from the back without losing it
+    IndexedMap<std::string,int> s;
+    for (int i = 0; i < 50; ++i) CHECK(s.try_emplace("key-" + std::to_string(i), i).second);
+    for (int i = 0; i < 50; i += 3) CHECK(s.erase("key-" + std::to_string(i)) == 1);
+    CHECK(s.size() == 33);
+    for (int i = 0; i < 50; ++i) {
+        const std::string k = "key-" + std::to_string(i);
+        CHECK(s.count(k) == (i % 3 != 0 ? 1u : 0u));
+        if (i % 3 != 0) CHECK(s.at(k) == i);
+    }
+}
+
+TEST_CASE("Storage: SmallAdjacency spills to heap and indexes high degree") {
+    SmallAdjacency<int> row;
+    for (int v = 0; v < 40; ++v) CHECK(row.try_emplace(v, v * 0.5).second);
+    CHECK_FALSE(row.try_emplace(7, 100.0).second);
+    CHECK(row.find(7)->second == doctest::Approx(3.5));
+    for (int v = 0; v < 40; v += 3) CHECK(row.erase(v) == 1);
+    CHECK(row.erase(0) == 0);
+    for (int v = 0; v < 40; ++v) CHECK(row.count(v) == (v % 3 != 0 ? 1u : 0u));
+    SmallAdjacency<int> copy(row);
+    CHECK(copy.size() == row.size());
+    CHECK(copy.find(38)->second == doctest::Approx(19.0));
+}
+
+TEST_CASE("Storage: DenseMap rejects negative labels") {
+    Graph<int, DenseStorage> g(0,false);
+    CHECK_THROWS_AS(g.add_edge(-1, 2, 1.0), std::out_of_range);
+}
+
+TEST_CASE_TEMPLATE("Storage: facades agree across backends", S, HashStorage, FlatHashStorage, DenseStorage, CowStorage, CompactStorage<>, PmrStorage) {
+    // undirected: MST weight, components, Hamilton, Euler
+    Graph<int, S> u(0,false);
+    for (int i = 0; i < 6; ++i) u.add_edge(i, (i+1)%6, 1.0 + i);
+    u.add_edge(0, 3, 0.5);
+    u.add_edge(7, 8, 2.0);
+    u.add_edge(8, 7, 9.0); // first weight wins
+    double total = 0;
+    for (auto& e : u.prims_algorithm(0)) total += e.edge_weight;
+    CHECK(total == doctest::Approx(0.5 + 1.0 + 2.0 + 4.0 + 5.0));
+    CHECK(u.kosarajus_algorithm_scc().size() == 2);
+    CHECK(u.in_degree(3) == 3);
+    u.remove_edge(0, 3);
+    CHECK(u.degree(3) == 2);
+    auto ham = u.hamilton_cycle(0);
+    CHECK(ham.empty()); // 7-8 is unreachable from 0
+    u.remove_edge(7, 8);
+    CHECK(u.is_eulerian());
+    CHECK(u.euler_circuit().size() == 7);
+
+    // directed: SCC, max-flow, arborescence
+    Graph<int, S> d(0,true);
+    d.add_edge(0,1,3.0); d.add_edge(0,2,2.0); d.add_edge(1,2,1.0);
+    d.add_edge(1,3,2.0); d.add_edge(2,3,3.0); d.add_edge(3,0,1.0);
+    d.add_edge(4,4,1.0);
+    CHECK(d.kosarajus_algorithm_scc().size() == 2);
+    CHECK(d.strongly_connected_components(SccEngine::tarjan).size() == 2);
+    CHECK(d.strongly_connected_components(SccEngine::parallel, 2).size() == 2);
+    CHECK(d.edmon_karp_algorithm(0,3) == doctest::Approx(5.0));
+    CHECK(d.prims_algorithm(0).empty()); // 4 is unreachable from 0
+    d.remove_edge(4,4);
+    CHECK(d.freeze().arc_count() == 6);
+    std::ostringstream os; os << d;
+    CHECK(os.str().find("(3, 2") != std::string::npos);
+}
+
+// ============================== Section: Copy-on-write Snapshots ==============================
+
+TEST_CASE("COW: snapshot is isolated from later edits on both sides") {
+    Graph<int, CowStorage> g(0,true);
+    for (int i = 0; i < 2000; ++i) g.add_edge(i, (i+1) % 2000, 1.0);
+    Graph<int, CowStorage> snap(g);
+
+    g.add_edge(0, 1000, 5.0);
+    g.remove_edge(1, 2);
+    g.add_edge(5000, 0, 1.0); // new vertex after the snapshot
+    snap.add_edge(7, 9, 2.0);
+
+    CHECK(snap.degree(0) == 1);
+    CHECK(snap.degree(1) == 1);
+    CHECK(snap.in_degree(0) == 1);
+    CHECK(snap.vertex_index().size() == 2000);
+    CHECK(snap.vertex_index().id_of(5000) == VertexIndex<int>::npos);
+    CHECK(snap.is_eulerian() == false); // 7->9 unbalances it
+    CHECK(snap.kosarajus_algorithm_scc().size() == 1);
+
+    CHECK(g.degree(0) == 2);
+    CHECK(g.degree(1) == 0);
+    CHECK(g.in_degree(0) == 2);
+    CHECK(g.vertex_index().id_of(5000) == 2000);
+    CHECK(g.degree(7) == 1);
+
+    Graph<int, CowStorage> again = snap;
+    again.remove_edge(7, 9);
+    CHECK(again.is_eulerian());
+    CHECK(snap.degree(7) == 2);
+}
+
+TEST_CASE("COW: CowVector chunks are shared until written") {
+    CowVector<int, 2> a;
+    for (int i = 0; i < 10; ++i) a.push_back(i);
+    CowVector<int, 2> b = a;
+    b[9] = 90;
+    b.push_back(10);
+    a[0] = -1;
+    CHECK(a[9] == 9);
+    CHECK(a.size() == 10);
+    CHECK(b[0] == 0);
+    CHECK(b[9] == 90);
+    CHECK(b[10] == 10);
+}
+
+// ============================== Section: Versioned Deltas ==============================
+
+TEST_CASE("Delta: version moves only on effective mutations") {
+    Graph<int> g(0,false);
+    CHECK(g.version() == 0);
+    g.add_edge(1, 2, 1.0);
+    const auto v1 = g.version();
+    CHECK(v1 > 0);
+    g.add_edge(2, 1, 5.0);          // existing edge, first weight wins
+    g.remove_edge(3, 4);            // missing edge
+    g.add_vertex(1);
+    CHECK(g.version() == v1);
+    g.add_vertex(9);
+    CHECK(g.version() > v1);
+    const auto v2 = g.version();
+    g.remove_edge(1, 2);
+    CHECK(g.version() > v2);
+    g.add_edges({{1, 2, 1.0}});
+    CHECK(g.version() > v2 + 1);
+}
+
+TEST_CASE("Delta: apply matches the individual calls and bumps the version once") {
+    for (bool directed : {false, true}) {
+        Graph<int> a(0, directed), b(0, directed);
+        for (int u = 0; u < 80; ++u)
+            for (int v : {(u+1) % 80, (u*7+3) % 80}) { a.add_edge(u, v, 1.0 + u % 5); b.add_edge(u, v, 1.0 + u % 5); }
+
+        GraphDelta<int> delta;
+        for (int u = 0; u < 80; u += 3) delta.erase(u, (u+1) % 80);
+        delta.erase(500, 501);                    // ignored
+        delta.insert(0, 40, 2.5).insert(100, 0, 1.0).insert(3, 4, 9.0); // 3-4 deleted above: re-inserted with the new weight
+        CHECK(delta.size() == 31);
+
+        for (const auto& [u, v] : delta.deletions) b.remove_edge(u, v);
+        b.add_edges(delta.insertions);
+
+        const auto before = a.version();
+        CHECK(a.apply(delta) == before + 1);
+        CHECK(a.version() == before + 1);
+        CHECK(a.to_string_with_weights() == b.to_string_with_weights());
+        CHECK(a.component_count() == b.component_count());
+        CHECK(a.unbalanced_vertices() == b.unbalanced_vertices());
+        CHECK(to_set_of_sets(a.kosarajus_algorithm_scc()) == to_set_of_sets(b.kosarajus_algorithm_scc()));
+
+        CHECK(a.apply(GraphDelta<int>{}) == before + 1); // empty delta changes nothing
+        GraphDelta<int> noop; noop.erase(500, 501).insert(0, 40, 7.0);
+        CHECK(a.apply(noop) == before + 1);
+    }
+}
+
+TEST_CASE("Delta: a delta the storage rejects leaves the graph untouched") {
+    Graph<int, DenseStorage> g(0,true);
+    for (int i = 0; i < 10; ++i) g.add_edge(i, (i+1) % 10, 1.0 + i);
+    const auto edges = g.to_string_with_weights();
+    const auto before = g.version();
+
+    GraphDelta<int> delta;
+    delta.erase(0, 1).erase(4, 5).insert(2, 7, 3.0).insert(-3, 2, 1.0);
+    CHECK_THROWS_AS(g.apply(delta), std::out_of_range);
+    CHECK(g.version() == before);
+    CHECK(g.to_string_with_weights() == edges);
+
+    delta.insertions.pop_back();        // without the bad label it goes through
+    Graph<int, DenseStorage> expected(g);
+    expected.remove_edge(0, 1);
+    expected.remove_edge(4, 5);
+    expected.add_edge(2, 7, 3.0);
+    CHECK(g.apply(delta) == before + 1);
+    CHECK(g.to_string_with_weights() == expected.to_string_with_weights());
+}
+
+TEST_CASE("Delta: snapshot() is rebuilt only after a mutation") {
+    Graph<int> g(0,true);
+    for (int i = 0; i < 50; ++i) g.add_edge(i, (i+1) % 50, 1.0);
+    auto s1 = g.snapshot();
+    CHECK(g.snapshot() == s1);
+    CHECK(s1->arc_count() == 50);
+
+    Graph<int> copy(g);
+    CHECK(copy.snapshot() == s1);   // carried along with the version
+
+    g.apply(GraphDelta<int>{}.insert(0, 25, 1.0).erase(1, 2));
+    auto s2 = g.snapshot();
+    CHECK(s2 != s1);
+    CHECK(s2->arc_count() == 50);
+    CHECK(s1->arc_count() == 50);   // readers keep their snapshot
+    CHECK(to_set_of_sets(s2->kosarajus_algorithm_scc()) == to_set_of_sets(g.kosarajus_algorithm_scc()));
+
+    copy.add_edge(7, 30, 1.0);      // same version number as g now, different contents
+    CHECK(copy.version() == g.version());
+    CHECK(copy.snapshot()->arc_count() == 51);
+    CHECK(g.snapshot() == s2);
+}
+
+// ============================== Section: Arena Allocation ==============================
+
+// Forwards to the heap and counts what passes through
+struct CountingResource : std::pmr::memory_resource {
+    size_t allocations = 0, live_bytes = 0;
+    void* do_allocate(size_t bytes, size_t align) override {
+        ++allocations; live_bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        live_bytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+TEST_CASE("Arena: PmrStorage graph allocates from its resource, copies onto another") {
+    CountingResource home, job;
+    {
+        Graph<int, PmrStorage> g(0, true, &home);
+        for (int i = 0; i < 200; ++i) g.add_edge(i, (i+1) % 200, 1.0);
+        CHECK(home.allocations > 0);
+        const size_t before = home.allocations;
+
+        Graph<int, PmrStorage> copy(g, &job);
+        CHECK(home.allocations == before); // nothing of the copy lands on the source resource
+        CHECK(job.allocations > 0);
+        copy.add_edge(0, 100, 2.0);
+        CHECK(copy.degree(0) == 2);
+        CHECK(g.degree(0) == 1);
+        CHECK(copy.kosarajus_algorithm_scc().size() == 1);
+    }
+    CHECK(home.live_bytes == 0);
+    CHECK(job.live_bytes == 0);
+}
+
+TEST_CASE("Arena: ScratchScope routes algorithm temporaries and keeps results") {
+    auto d = make_random_directed<int>(300, 0.02, 11);
+    Graph<int> u(0, false);
+    for (int i = 0; i < 60; ++i) u.add_edge(i, (i+1) % 60, 1.0 + i % 7);
+    const auto scc = to_set_of_sets(d.kosarajus_algorithm_scc());
+    const double flow = d.edmon_karp_algorithm(0, 1);
+    const auto mst = u.prims_algorithm(0).size();
+    const auto euler = u.euler_circuit();
+
+    CountingResource counter;
+    {
+        std::pmr::monotonic_buffer_resource arena(&counter);
+        {
+            arena::ScratchScope scope(&arena);
+            CHECK(arena::scratch_resource() == &arena);
+            CHECK(to_set_of_sets(d.kosarajus_algorithm_scc()) == scc);
+            CHECK(d.edmon_karp_algorithm(0, 1) == doctest::Approx(flow));
+            CHECK(u.prims_algorithm(0).size() == mst);
+            CHECK(u.euler_circuit() == euler);
+        }
+        CHECK(arena::scratch_resource() == std::pmr::get_default_resource());
+        CHECK(counter.allocations > 0);
+        CHECK(counter.live_bytes > 0); // monotonic: held until the arena goes away
+    }
+    CHECK(counter.live_bytes == 0);   // released in one shot
+}
+
+// ============================== Section: Memory Accounting ==============================
+
+TEST_CASE("Memory: memory_usage follows edges and storage layout") {
+    Graph<int> g(0,false);
+    const MemoryUsage empty = g.memory_usage();
+    CHECK(empty.nodes == 0);
+    CHECK(empty.bytes >= sizeof(g));
+    for (int i = 0; i < 100; ++i) g.add_edge(i, (i+1) % 100, 1.0);
+    const MemoryUsage m = g.memory_usage();
+    CHECK(m.nodes >= 100 + 200 + 100); // vertex nodes + arc nodes + index nodes
+    CHECK(m.buckets >= 100);
+    CHECK(m.bytes > empty.bytes + 200 * sizeof(std::pair<const int, double>));
+
+    Graph<int, CompactStorage<>> c(0,false);
+    for (int i = 0; i < 100; ++i) c.add_edge(i, (i+1) % 100, 1.0);
+    CHECK(c.memory_usage().bytes < m.bytes);
+
+    // Copy-on-write snapshots report everything they can reach
+    Graph<int, CowStorage> w(0,false);
+    for (int i = 0; i < 100; ++i) w.add_edge(i, (i+1) % 100, 1.0);
+    Graph<int, CowStorage> snap(w);
+    CHECK(snap.memory_usage().bytes == w.memory_usage().bytes);
+}
+
+TEST_CASE("Memory: CompactStorage rounds weights to the stored type") {
+    Graph<int, CompactStorage<std::int32_t>> g(0,true);
+    g.add_edge(0, 1, 2.9);
+    g.add_edge(1, 2, -1.5);
+    double total = 0;
+    for (auto& e : g.prims_algorithm(0)) total += e.edge_weight;
+    CHECK(total == doctest::Approx(1.0)); // 2 + (-1)
+    CHECK(g.edmon_karp_algorithm(0, 2) == doctest::Approx(0.0));
+
+    Graph<int, CompactStorage<float>> f(0,false);
+    f.add_edge(0, 1, 0.1);
+    CHECK(f.prims_algorithm(0).front().edge_weight == doctest::Approx(0.1f));
+}
+
 // ============================== Section: Stress / Performance ==============================
 
 #if HEAVY_TESTS && ENABLE_PERF_TESTS
 
+TEST_CASE("Perf: SCC on frozen CSR snapshot of large directed graph") {
+    const int N = SZ(12000);
+    const double p = 4.0 / N;
+    auto g = make_random_directed<int>(N, p, 7);
+    auto t0 = std::chrono::steady_clock::now();
+    auto csr = g.freeze();
+    auto comps = csr.kosarajus_algorithm_scc();
+    auto t1 = std::chrono::steady_clock::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    INFO("N=" << N << " p=" << p << " ms=" << ms << " num_comps=" << comps.size());
+    CHECK(ms < PERF_MS_LIMIT);
+    CHECK(to_set_of_sets(comps).size() == g.kosarajus_algorithm_scc().size());
+}
+
 TEST_CASE("Perf: Connected Components on large undirected sparse graph") {
     const int N = SZ(9000);
     const double p = 3.0 / N;
@@ -678,6 +1906,160 @@ TEST_CASE("Perf: Euler circuit on large even-degree ring") {
     CHECK(circuit.size() == static_cast<size_t>(N+1));
 }
 
+TEST_CASE("Perf: directed Euler check on large directed cycle") {
+    const int N = SZ(50000);
+    auto g = make_directed_cycle<int>(N);
+    auto t0 = std::chrono::steady_clock::now();
+    bool ok = g.is_eulerian();
+    auto t1 = std::chrono::steady_clock::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    INFO("N=" << N << " ms=" << ms);
+    CHECK(ok);
+    CHECK(ms < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: repeated Euler checks on a growing graph reuse the union-find") {
+    const int N = SZ(100000);
+    Graph<int> g = make_cycle_graph<int>(N, false, 1.0);
+    auto t0 = std::chrono::steady_clock::now();
+    int eulerian = 0;
+    for (int i = 0; i < 200; ++i) {
+        eulerian += g.is_eulerian();
+        CHECK(g.component_count() == size_t(1 + i));
+        g.add_vertex(N + i);
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    INFO("N=" << N << " ms=" << ms);
+    CHECK(eulerian == 200);
+    CHECK(ms < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: rejecting non-Eulerian graphs is O(1) per request") {
+    const int N = SZ(200000);
+    Graph<int> g = make_cycle_graph<int>(N, true, 1.0);
+    g.add_edge(0, N / 2, 1.0); // one extra arc unbalances two vertices
+    auto t0 = std::chrono::steady_clock::now();
+    int eulerian = 0;
+    for (int i = 0; i < 100000; ++i) eulerian += g.is_eulerian();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    INFO("N=" << N << " ms=" << ms);
+    CHECK(eulerian == 0);
+    CHECK(g.euler_circuit().empty());
+    CHECK(g.unbalanced_vertices() == 2);
+    CHECK(ms < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: loading a binary snapshot vs rebuilding from an edge list") {
+    const int N = SZ(200000);
+    const std::string path = "snapshot_perf.osg";
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> d(0, N-1);
+    std::vector<Graph<int>::edge_tuple> edges;
+    for (int i = 0; i < 5*N; ++i) edges.emplace_back(d(rng), d(rng), 1.0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    Graph<int> g(0,true);
+    g.add_edges(edges);
+    CSRGraph<int> built = g.freeze();
+    auto t1 = std::chrono::steady_clock::now();
+    save_snapshot(built, path);
+    auto t2 = std::chrono::steady_clock::now();
+    CSRGraph<int> loaded = load_snapshot<int>(path);
+    auto t3 = std::chrono::steady_clock::now();
+    auto ms_build = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    auto ms_load  = std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count();
+    INFO("N=" << N << " arcs=" << loaded.arc_count() << " build ms=" << ms_build << " load ms=" << ms_load);
+    CHECK(loaded.arc_count() == built.arc_count());
+    CHECK(loaded.kosarajus_algorithm_scc().size() == built.kosarajus_algorithm_scc().size());
+    CHECK(ms_load < PERF_MS_LIMIT);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Perf: parallel CSR build from a raw edge list vs add_edges + freeze") {
+    const int N = SZ(200000);
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> d(0, N-1);
+    std::vector<CSRGraph<int>::edge_tuple> edges;
+    for (int i = 0; i < 5*N; ++i) edges.emplace_back(d(rng), d(rng), 1.0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    Graph<int> g(0,true);
+    g.add_edges(edges);
+    CSRGraph<int> via_graph = g.freeze();
+    auto t1 = std::chrono::steady_clock::now();
+    CSRGraph<int> sorted = CSRGraph<int>::from_edges(edges, true);
+    auto t2 = std::chrono::steady_clock::now();
+    CSRGraph<int> raw = CSRGraph<int>::from_edges(edges, true, false);
+    auto t3 = std::chrono::steady_clock::now();
+    auto ms = [](auto a, auto b){ return std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count(); };
+    INFO("N=" << N << " threads=" << parallel::thread_count(edges.size()) << " graph+freeze ms=" << ms(t0, t1)
+         << " from_edges ms=" << ms(t1, t2) << " unsorted ms=" << ms(t2, t3));
+    CHECK(sorted.arc_count() == via_graph.arc_count());
+    CHECK(raw.arc_count() == edges.size());
+    CHECK(ms(t1, t2) < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: 100k-vertex sparse G(n,p) and G(n,m) generation") {
+    const int N = SZ(100000);
+    auto t0 = std::chrono::steady_clock::now();
+    auto gnp = generators::gnp<int>(N, 10.0 / N, false, 99, generators::uniform_weight{1.0, 10.0});
+    auto t1 = std::chrono::steady_clock::now();
+    auto gnm = generators::gnm<int>(N, 5 * N, true, 99);
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms = [](auto a, auto b){ return std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count(); };
+    INFO("N=" << N << " gnp edges=" << gnp.size() << " ms=" << ms(t0, t1) << " gnm ms=" << ms(t1, t2));
+    CHECK(gnm.size() == static_cast<std::size_t>(5 * N));
+    CHECK(gnp.size() > static_cast<std::size_t>(4 * N));
+    CHECK(ms(t0, t2) < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: hub-heavy graphs through Prim and Edmonds-Karp") {
+    const int N = SZ(50000);
+    Graph<int> ba(0, false);
+    ba.add_edges(generators::barabasi_albert<int>(N, 4, 31, generators::uniform_weight{1.0, 100.0}));
+    Graph<int> rm(0, true);
+    rm.add_edges(generators::rmat<int>(15, 8 * (1 << 15), true, 31, generators::uniform_int_weight{1, 20}));
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto mst = ba.prims_algorithm(0);
+    auto t1 = std::chrono::steady_clock::now();
+    const double flow = rm.edmon_karp_algorithm(0, 1);
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms = [](auto a, auto b){ return std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count(); };
+    INFO("BA N=" << N << " prim ms=" << ms(t0, t1) << " | rmat arcs=" << rm.freeze().arc_count()
+         << " flow=" << flow << " edmonds-karp ms=" << ms(t1, t2));
+    CHECK(mst.size() == static_cast<std::size_t>(N - 1));
+    CHECK(ms(t0, t2) < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: SCC and connected components before and after vertex reordering") {
+    const unsigned scale = 17;
+    std::vector<int> label(1u << scale);
+    std::iota(label.begin(), label.end(), 0);
+    std::shuffle(label.begin(), label.end(), std::mt19937(8));
+    auto edges = generators::rmat<int>(scale, 8u << scale, true, 8);
+    for (auto& [u, v, w] : edges) { u = label[u]; v = label[v]; }
+    std::shuffle(edges.begin(), edges.end(), std::mt19937(9));
+    auto base = CSRGraph<int>::from_edges(edges, true);
+
+    auto time_scc = [](const CSRGraph<int>& g, std::size_t& comps){
+        auto t0 = std::chrono::steady_clock::now();
+        comps = g.kosarajus_algorithm_scc().size();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    };
+    std::size_t c0 = 0, c1 = 0, c2 = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    auto rcm = reorder(base, VertexOrder::rcm);
+    auto by_degree = reorder(base, VertexOrder::degree);
+    auto reorder_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    auto ms_base = time_scc(base, c0), ms_rcm = time_scc(rcm, c1), ms_deg = time_scc(by_degree, c2);
+    INFO("arcs=" << base.arc_count() << " reorder ms=" << reorder_ms << " scc ms: scrambled=" << ms_base
+         << " rcm=" << ms_rcm << " degree=" << ms_deg);
+    CHECK(c0 == c1);
+    CHECK(c0 == c2);
+    CHECK(ms_rcm < PERF_MS_LIMIT);
+}
+
 TEST_CASE("Perf: SCC on large directed graph") {
     const int N = SZ(12000);
     const double p = 4.0 / N;
@@ -691,6 +2073,69 @@ TEST_CASE("Perf: SCC on large directed graph") {
     CHECK(!comps.empty());
 }
 
+TEST_CASE("Perf: Tarjan SCC against Kosaraju on a large directed graph") {
+    const int N = SZ(12000);
+    auto g = make_random_directed<int>(N, 4.0 / N, 7);
+    auto t0 = std::chrono::steady_clock::now();
+    auto tarjan = g.strongly_connected_components(SccEngine::tarjan);
+    auto t1 = std::chrono::steady_clock::now();
+    auto kosaraju = g.kosarajus_algorithm_scc();
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms_tarjan = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    auto ms_kosaraju = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+    INFO("N=" << N << " tarjan_ms=" << ms_tarjan << " kosaraju_ms=" << ms_kosaraju << " num_comps=" << tarjan.size());
+    CHECK(to_set_of_sets(tarjan) == to_set_of_sets(kosaraju));
+    CHECK(ms_tarjan < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: parallel SCC scaling from 1 to N threads") {
+    const int N = SZ(40000); // the Very-Heavy SCC graph
+    auto g = make_random_directed<int>(N, 4.0 / N, 123456);
+    const auto snap = g.snapshot();
+    auto t0 = std::chrono::steady_clock::now();
+    const auto expected = to_set_of_sets(snap->kosarajus_algorithm_scc());
+    auto t1 = std::chrono::steady_clock::now();
+    std::ostringstream times;
+    times << " kosaraju=" << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms";
+    const size_t hw = std::max(4u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= hw; threads *= 2) {
+        auto a = std::chrono::steady_clock::now();
+        const auto comps = snap->strongly_connected_components(SccEngine::parallel, threads);
+        auto b = std::chrono::steady_clock::now();
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count();
+        times << " t" << threads << "=" << ms << "ms";
+        CHECK(to_set_of_sets(comps) == expected);
+        CHECK(ms < PERF_MS_LIMIT);
+    }
+    MESSAGE("parallel SCC, V=" << N << " E=" << snap->arc_count() << ":" << times.str());
+}
+
+TEST_CASE("Perf: Afforest connected components scaling from 1 to N threads") {
+    const int N = SZ(200000);
+    namespace gen = generators;
+    const auto snap = CSRGraph<int>::from_edges(gen::gnp<int>(N, 8.0 / N, false, 77, gen::uniform_int_weight{1, 9}), false);
+    auto t0 = std::chrono::steady_clock::now();
+    UnionFind<> sets(snap.vertex_count());
+    for (uint32_t u = 0; u < snap.vertex_count(); ++u)
+        for (size_t a = snap.arc_begin(u); a < snap.arc_end(u); ++a) sets.unite(u, snap.target(a));
+    auto t1 = std::chrono::steady_clock::now();
+    std::ostringstream times;
+    times << " union-find=" << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms";
+    const size_t hw = std::max(4u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= hw; threads *= 2) {
+        auto a = std::chrono::steady_clock::now();
+        const auto labels = snap.component_labels(threads);
+        auto b = std::chrono::steady_clock::now();
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count();
+        times << " t" << threads << "=" << ms << "ms";
+        size_t count = 0;
+        for (uint32_t v = 0; v < labels.size(); ++v) count += labels[v] == v;
+        CHECK(count == sets.sets());
+        CHECK(ms < PERF_MS_LIMIT);
+    }
+    MESSAGE("Afforest CC, V=" << snap.vertex_count() << " E=" << snap.arc_count() << ":" << times.str());
+}
+
 TEST_CASE("Perf: Max-Flow on layered network") {
     const int layers = SZ(6);
     const int L = SZ(30);
@@ -704,6 +2149,73 @@ TEST_CASE("Perf: Max-Flow on layered network") {
     CHECK(ms < PERF_MS_LIMIT);
 }
 
+TEST_CASE("Perf: Dinic on a wide layered network") {
+    const int layers = 40, width = SZ(100); // thousands of vertices
+    Graph<int> g(0, true);
+    g.add_edges(generators::layered_flow<int>(layers, width, 6, 17, generators::uniform_int_weight{1, 20}));
+    const int sink = 1 + layers * width;
+    auto t0 = std::chrono::steady_clock::now();
+    const double dinic = g.max_flow(0, sink, FlowEngine::dinic);
+    auto t1 = std::chrono::steady_clock::now();
+    const double ek = g.edmon_karp_algorithm(0, sink);
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms_dinic = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    auto ms_ek = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+    INFO("V=" << g.vertex_index().size() << " flow=" << dinic << " dinic_ms=" << ms_dinic << " ek_ms=" << ms_ek);
+    CHECK(dinic == doctest::Approx(ek));
+    CHECK(ms_dinic < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: push-relabel on a dense capacity graph") {
+    const int n = SZ(400);
+    auto g = make_random_directed<int>(n, 0.3, 23, 1.0, 100.0);
+    auto t0 = std::chrono::steady_clock::now();
+    const double pr = g.max_flow(0, n - 1, FlowEngine::push_relabel);
+    auto t1 = std::chrono::steady_clock::now();
+    const double ek = g.edmon_karp_algorithm(0, n - 1);
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms_pr = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    auto ms_ek = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+    INFO("V=" << n << " E=" << g.freeze().arc_count() << " flow=" << pr << " pr_ms=" << ms_pr << " ek_ms=" << ms_ek);
+    CHECK(pr == doctest::Approx(ek));
+    CHECK(ms_pr < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf: parallel push-relabel scaling from 1 to N threads") {
+    const int n = SZ(1500);
+    auto g = make_random_directed<int>(n, 0.05, 29, 1.0, 100.0);
+    const auto snap = g.freeze();
+    const size_t hw = std::max(4u, std::thread::hardware_concurrency());
+    const double expected = snap.max_flow(0, n - 1, FlowEngine::push_relabel);
+    std::ostringstream times;
+    for (size_t threads = 1; threads <= hw; threads *= 2) {
+        auto t0 = std::chrono::steady_clock::now();
+        const double value = snap.max_flow(0, n - 1, FlowEngine::parallel_push_relabel, threads);
+        auto t1 = std::chrono::steady_clock::now();
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+        times << " t" << threads << "=" << ms << "ms";
+        CHECK(value == doctest::Approx(expected));
+        CHECK(ms < PERF_MS_LIMIT);
+    }
+    MESSAGE("parallel push-relabel, V=" << n << " E=" << snap.arc_count() << ":" << times.str());
+}
+
+TEST_CASE("Perf: repeated max-flow queries reuse one FlowNetwork") {
+    const int n = SZ(2000);
+    auto g = make_random_directed<int>(n, 8.0 / n, 41, 1.0, 10.0);
+    auto t0 = std::chrono::steady_clock::now();
+    double reused = 0, rebuilt = 0;
+    for (int q = 0; q < 20; ++q) reused += g.max_flow(q, n - 1 - q, FlowEngine::dinic);
+    auto t1 = std::chrono::steady_clock::now();
+    for (int q = 0; q < 20; ++q) rebuilt += g.residual_network().dinic(g.vertex_index().id_of(q), g.vertex_index().id_of(n - 1 - q));
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms_reused = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    auto ms_rebuilt = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+    INFO("n=" << n << " reused_ms=" << ms_reused << " rebuilt_ms=" << ms_rebuilt);
+    CHECK(reused == doctest::Approx(rebuilt));
+    CHECK(ms_reused < PERF_MS_LIMIT);
+}
+
 TEST_CASE("Perf: Hamilton attempt on dense complete graph (small due to exponential)") {
     // Hamilton is exponential; keep size modest but still non-trivial.
     const int n = 12; // do not scale blindly
@@ -880,4 +2392,102 @@ TEST_CASE("Perf-Micro: build and query degrees") {
     CHECK(ms < PERF_MS_LIMIT);
 }
 
+TEST_CASE("Perf-Micro: bulk add_edges vs repeated add_edge") {
+    const int N = SZ(200000);
+    const int M = SZ(2000000);
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> d(0, N-1);
+    std::vector<Graph<int>::edge_tuple> edges;
+    edges.reserve(M);
+    for (int i = 0; i < M; ++i) edges.emplace_back(d(rng), d(rng), 1.0);
+
+    Graph<int> seq(0,false), bulk(0,false);
+    auto t0 = std::chrono::steady_clock::now();
+    for (const auto& [u,v,w] : edges) seq.add_edge(u, v, w);
+    auto t1 = std::chrono::steady_clock::now();
+    bulk.add_edges(edges);
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms_seq  = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    auto ms_bulk = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+    INFO("M=" << M << " add_edge ms=" << ms_seq << " add_edges ms=" << ms_bulk);
+    CHECK(bulk.degree(0) == seq.degree(0));
+    CHECK(ms_bulk < PERF_MS_LIMIT);
+}
+
+TEST_CASE_TEMPLATE("Perf-Micro: build + SCC per storage backend", S, HashStorage, FlatHashStorage, DenseStorage, CowStorage, CompactStorage<>, PmrStorage) {
+    const int N = SZ(100000);
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> d(0, N-1);
+    auto t0 = std::chrono::steady_clock::now();
+    Graph<int, S> g(0,true);
+    for (int i = 0; i < 4*N; ++i) g.add_edge(d(rng), d(rng), 1.0);
+    auto t1 = std::chrono::steady_clock::now();
+    auto comps = g.kosarajus_algorithm_scc();
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms_build = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    auto ms_scc   = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+    INFO("N=" << N << " build ms=" << ms_build << " scc ms=" << ms_scc << " comps=" << comps.size());
+    CHECK(!comps.empty());
+    CHECK(ms_build + ms_scc < PERF_MS_LIMIT);
+}
+
+TEST_CASE("Perf-Micro: bytes per edge, default vs compact storage") {
+    const int N = SZ(100000);
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> d(0, N-1);
+    std::vector<Graph<int>::edge_tuple> edges;
+    for (int i = 0; i < 8*N; ++i) edges.emplace_back(d(rng), d(rng), 1.0 + (i % 7));
+    Graph<int> wide(0,false);
+    Graph<int, CompactStorage<>> compact(0,false);
+    wide.add_edges(edges);
+    compact.add_edges(edges);
+    const double per_edge_wide = double(wide.memory_usage().bytes) / edges.size();
+    const double per_edge_compact = double(compact.memory_usage().bytes) / edges.size();
+    INFO("N=" << N << " bytes/edge default=" << per_edge_wide << " compact=" << per_edge_compact);
+    CHECK(per_edge_compact * 2 < per_edge_wide);
+}
+
+TEST_CASE("Perf-Micro: commit snapshot + small edit, COW vs deep copy") {
+    // The Q_9 commit pattern: snapshot the client graph, then the client adds a few edges.
+    const int N = SZ(200000);
+    Graph<int> deep(0,true);
+    Graph<int, CowStorage> cow(0,true);
+    for (int i = 0; i < N; ++i) {
+        deep.add_edge(i, (i*7+1) % N, 1.0);
+        cow.add_edge(i, (i*7+1) % N, 1.0);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < 5; ++r) {
+        Graph<int> snap(deep);
+        deep.add_edge(r, r+2, 1.0);
+        CHECK(snap.degree(r) == 1);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < 5; ++r) {
+        Graph<int, CowStorage> snap(cow);
+        cow.add_edge(r, r+2, 1.0);
+        CHECK(snap.degree(r) == 1);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    auto ms_deep = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    auto ms_cow  = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
+    INFO("N=" << N << " deep copy ms=" << ms_deep << " cow ms=" << ms_cow);
+    CHECK(ms_cow <= ms_deep);
+}
+
+TEST_CASE("Perf-Micro: dense build with duplicate edge uploads") {
+    // Every edge is sent twice (both orientations), as the random client does.
+    const int N = SZ(700);
+    Graph<int> g(0,false);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int u=0; u<N; ++u)
+        for (int v=0; v<N; ++v)
+            if (u != v) g.add_edge(u, v, 1.0);
+    auto t1 = std::chrono::steady_clock::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    INFO("N=" << N << " ms=" << ms);
+    CHECK(g.degree(0) == static_cast<size_t>(N-1));
+    CHECK(ms < PERF_MS_LIMIT);
+}
+
 #endif // HEAVY_TESTS && ENABLE_PERF_TESTS
@@ -3,20 +3,36 @@
 #include <random>
 #include <thread>
 #include <memory>
+#include <functional>
+#include <cmath>
 #include <getopt.h>
 
 using std::cout;
 using std::endl;
 using namespace Graph_implementation;
 
+// -w: weight sampler by name (unit, uniform, int, exp, pareto); empty function if unknown
+static std::function<double(generators::rng_type&)> weight_sampler(const std::string& name) {
+    if (name == "unit") return generators::constant_weight{1.0};
+    if (name == "uniform") return generators::uniform_weight{1.0, 10.0};
+    if (name == "int") return generators::uniform_int_weight{1, 10};
+    if (name == "exp") return generators::exponential_weight{5.0};
+    if (name == "pareto") return generators::pareto_weight{1.0, 2.0};
+    return {};
+}
+
 int main(int argc, char* argv[]) {
 
     int v = -1;
     int e = -1;
     int random_seed = -1;
+    double p = -1.0;             // -p: edge probability for -g gnp
+    std::string model = "gnm";   // -g: gnm | gnp | rmat | ba | grid
+    std::string weights = "unit"; // -w: unit | uniform | int | exp | pareto
+    std::string snapshot_path; // -o: also write the generated graph as a binary snapshot
     int opt;
 
-    while ((opt = getopt(argc, argv, "v:e:r:")) != -1) {
+    while ((opt = getopt(argc, argv, "v:e:r:o:g:p:w:")) != -1) {
         switch (opt) {
             case 'v':
                 v = atoi(optarg);
@@ -27,38 +43,79 @@ int main(int argc, char* argv[]) {
             case 'r':
                 random_seed = atoi(optarg);
                 break;
+            case 'o':
+                snapshot_path = optarg;
+                break;
+            case 'g':
+                model = optarg;
+                break;
+            case 'p':
+                p = atof(optarg);
+                break;
+            case 'w':
+                weights = optarg;
+                break;
             default:
-                std::cerr << "Usage: " << argv[0] << " [-v <num_of_vertices(int)> -e <num_of_edeges(int)> -r <seed for?(int)>] " << endl;
+                std::cerr << "Usage: " << argv[0] << " [-v <num_of_vertices(int)> -e <num_of_edeges(int)> -r <seed for?(int)>] [-o <snapshot file>]\n"
+                          << "       [-g gnm|gnp|rmat|ba|grid] [-p <edge probability, gnp>] [-w unit|uniform|int|exp|pareto]\n"
+                          << "  gnm : exactly e uniform edges (default)   gnp : each pair with probability p (-e unused)\n"
+                          << "  rmat: power-law, 2^ceil(log2 v) vertices, e draws   ba: preferential attachment, e/v links per vertex\n"
+                          << "  grid: road-like sqrt(v) x sqrt(v) lattice (-e unused)" << endl;
                 return 1;
         }
     }
     cout << "=== Generating Graph ===" << endl;
 
-    if (v <= 0 || e <= 0 || random_seed < 0) {
+    const bool needs_e = model == "gnm" || model == "rmat" || model == "ba";
+    if (v <= 0 || (needs_e && e <= 0) || random_seed < 0) {
         std::cerr << "Invalid parameters! Please provide positive integers for vertices and edges, and a non-negative seed." << endl;
         return 1;
     }
-    if (e > v * (v - 1) / 2) {
-        std::cerr << "Too many edges! For " << v << " vertices, the maximum number of edges is " << v * (v - 1) / 2 << "." << endl;
+    const long long max_edges = static_cast<long long>(v) * (v - 1) / 2;
+    if (model == "gnm" && e > max_edges) {
+        std::cerr << "Too many edges! For " << v << " vertices, the maximum number of edges is " << max_edges << "." << endl;
+        return 1;
+    }
+    if (model == "gnp" && (p < 0.0 || p > 1.0)) {
+        std::cerr << "gnp needs an edge probability -p between 0 and 1." << endl;
+        return 1;
+    }
+    auto weight = weight_sampler(weights);
+    if (!weight) {
+        std::cerr << "Unknown weight distribution '" << weights << "'." << endl;
         return 1;
     }
     Graph<int> G(v, false); // Create an undirected graph with v vertices
-    
-    std::mt19937 rng(random_seed);
-    std::uniform_int_distribution<int> dist(0, v - 1);
-    int added_edges = 0;
-    std::set<std::pair<int, int>> edge_set;
-    int weight = 1; // Weight for edges, can be adjusted
 
-    while (added_edges < e) {
-        int u = dist(rng);
-        int w = dist(rng);
-        if (u == w) continue; // No self-loops
-        auto edge = std::minmax(u, w);
-        if (edge_set.count(edge)) continue; // No duplicate edges
-        G.add_edge(u, w, weight);
-        edge_set.insert(edge);
-        ++added_edges;
+    // No self-loops or repeated edges, reproducible from the seed
+    std::vector<Graph<int>::edge_tuple> edges;
+    if (model == "gnm") {
+        edges = generators::gnm<int>(v, e, false, random_seed, weight);
+    } else if (model == "gnp") {
+        edges = generators::gnp<int>(v, p, false, random_seed, weight);
+    } else if (model == "rmat") {
+        unsigned scale = 1;
+        while ((1ull << scale) < static_cast<unsigned long long>(v)) ++scale;
+        edges = generators::rmat<int>(scale, e, false, random_seed, weight);
+    } else if (model == "ba") {
+        edges = generators::barabasi_albert<int>(v, std::max(1, e / v), random_seed, weight);
+    } else if (model == "grid") {
+        const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(v))));
+        edges = generators::grid<int>(side, side, random_seed, weight);
+    } else {
+        std::cerr << "Unknown graph model '" << model << "'." << endl;
+        return 1;
+    }
+    G.add_edges(edges); // one bulk build instead of e add_edge calls
+
+    if (!snapshot_path.empty()) {
+        try {
+            save_snapshot(G.freeze(), snapshot_path);
+            cout << "Snapshot written to " << snapshot_path << endl;
+        } catch (const std::exception& ex) {
+            std::cerr << "Error: " << ex.what() << endl;
+            return 1;
+        }
     }
 
     cout << "\n----- Graph Representation -----" << endl;
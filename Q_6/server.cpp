@@ -40,14 +40,9 @@ static void handle_sigint(int) {
 // ================= Helper: generate random unweighted graph =================
 std::shared_ptr<Graph<int>> generate_random_graph(int vertices, double p) {
     auto graph = std::make_shared<Graph<int>>(vertices);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> prob(0.0, 1.0);
-
-    for (int u = 0; u < vertices; ++u)
-        for (int v = u + 1; v < vertices; ++v)
-            if (prob(gen) <= p) graph->add_edge(u + 1, v + 1, 0);
-
+    auto edges = generators::gnp<int>(vertices, p, false, std::random_device{}(), generators::constant_weight{0});
+    for (auto& [u, v, w] : edges) { ++u; ++v; } // vertices are numbered 1..n
+    graph->add_edges(edges);
     return graph;
 }
 
@@ -13,10 +13,10 @@
 
 //Custom Factory for generating The requested algorithm
 
-template <typename T>
+template <typename T, typename Storage = HashStorage>
 class AlgorithmsFactory {
 public:
-    static std::unique_ptr<AlgorithmIO<T>> create(const Request<T>& req) {
+    static std::unique_ptr<AlgorithmIO<T, Storage>> create(const Request<T, Storage>& req) {
         // normalize name to lowercase
         std::string name = req.name;
         std::transform(name.begin(), name.end(), name.begin(),
@@ -26,19 +26,34 @@ public:
 
 
         if (name == "hamilton") {
-            return std::make_unique<HamiltonAlgo<T>>();
+            return std::make_unique<HamiltonAlgo<T, Storage>>();
         }
         else if (name == "euler cycle" || name == "eulerian circuit" || name == "euler") {
-            return std::make_unique<EulerAlgo<T>>();
+            return std::make_unique<EulerAlgo<T, Storage>>();
         }
         else if (name == "scc" || name == "strongly connected components") {
-            return std::make_unique<SCC_Algo<T>>();
+            return std::make_unique<SCC_Algo<T, Storage>>();
+        }
+        else if (name == "tarjan") {
+            return std::make_unique<SCC_Algo<T, Storage>>(SccEngine::tarjan);
+        }
+        else if (name == "parallel-scc") {
+            return std::make_unique<SCC_Algo<T, Storage>>(SccEngine::parallel);
         }
         else if (name == "maxflow" || name == "edmonds-karp") {
-            return std::make_unique<MaxFlow<T>>();
+            return std::make_unique<MaxFlow<T, Storage>>();
+        }
+        else if (name == "dinic") {
+            return std::make_unique<MaxFlow<T, Storage>>(FlowEngine::dinic);
+        }
+        else if (name == "push-relabel") {
+            return std::make_unique<MaxFlow<T, Storage>>(FlowEngine::push_relabel);
+        }
+        else if (name == "parallel-push-relabel") {
+            return std::make_unique<MaxFlow<T, Storage>>(FlowEngine::parallel_push_relabel);
         }
         else if (name == "mst" || name == "prim") {
-            return std::make_unique<MSTAlgo<T>>();
+            return std::make_unique<MSTAlgo<T, Storage>>();
         }
        
         return nullptr;
@@ -3,6 +3,7 @@
 #include <vector>
 #include <sstream>
 #include <optional>
+#include <map>
 
 #include "../../Q_1_to_4/Graph/Graph.hpp"
 
@@ -10,20 +11,28 @@
 contain a type T value or no value at all(std::nullopt)*/
 using namespace Graph_implementation;
 
-template <typename T>
+template <typename T, typename Storage = HashStorage>
 struct Request {
   std::string name;
-  Graph<T>& graph;
+  Graph<T, Storage>& graph;
   std::optional<T> start;  // For Hamilton or MST
   std::optional<T> source; // For Max flow
   std::optional<T> sink;   // For Max flow
+  std::map<std::string, std::string> options; // Trailing key=value fields (e.g. engine=dinic)
 
   // Explicit ctor
-  Request(Graph<T>& g, std::string nm,
+  Request(Graph<T, Storage>& g, std::string nm,
           std::optional<T> st = {},
           std::optional<T> src = {},
-          std::optional<T> snk = {})
-    : name(std::move(nm)), graph(g), start(st), source(src), sink(snk) {}
+          std::optional<T> snk = {},
+          std::map<std::string, std::string> opts = {})
+    : name(std::move(nm)), graph(g), start(st), source(src), sink(snk), options(std::move(opts)) {}
+
+  // Value of option 'key', or 'fallback' if it was not given
+  std::string option(const std::string& key, const std::string& fallback = "") const {
+    auto it = options.find(key);
+    return it == options.end() ? fallback : it->second;
+  }
 };
 
 
@@ -35,11 +44,11 @@ struct Response{
 };
 
 
-template <typename T>
+template <typename T, typename Storage = HashStorage>
 class AlgorithmIO{
     public:
     virtual ~AlgorithmIO() = default;
-    virtual Response run(const Request<T>& request) = 0;
+    virtual Response run(const Request<T, Storage>& request) = 0;
 };
 
 
@@ -10,10 +10,10 @@
 // The graph must expose a unified API:
 //   std::vector<T> euler_circuit() const;
 // which dispatches internally based on graph directedness.
-template <typename T>
-class EulerAlgo : public AlgorithmIO<T> {
+template <typename T, typename Storage = HashStorage>
+class EulerAlgo : public AlgorithmIO<T, Storage> {
 public:
-    Response run(const Request<T>& req) override {
+    Response run(const Request<T, Storage>& req) override {
         // Ask the graph for an Eulerian circuit (directed or undirected).
         std::vector<T> cycle = req.graph.euler_circuit();
 
@@ -3,20 +3,41 @@
 
 
 
-template <typename T>
+template <typename T, typename Storage = HashStorage>
 
-class MaxFlow : public AlgorithmIO<T>{
+class MaxFlow : public AlgorithmIO<T, Storage>{
+    public:
+    explicit MaxFlow(FlowEngine default_engine = FlowEngine::edmonds_karp) : engine_(default_engine) {}
 
-    virtual Response run(const Request<T>& req ) override{
+    // Option engine=ek|dinic|pr|ppr overrides the factory default; threads=N sets the cores used
+    // by ppr (parallel push–relabel, default: all of them)
+    virtual Response run(const Request<T, Storage>& req ) override{
         if(!req.source||!req.sink) 
         return {false,"Missing source or sink"};
 
         const T& source = *req.source;
         const T& sink = *req.sink;
 
-        double value = req.graph.edmon_karp_algorithm(source,sink);
+        FlowEngine engine = engine_;
+        const std::string name = req.option("engine");
+        if (!name.empty()) {
+            try { engine = parse_flow_engine(name); }
+            catch (const std::invalid_argument& e) { return {false, e.what()}; }
+        }
+
+        std::size_t threads = 0;
+        const std::string count = req.option("threads");
+        if (!count.empty()) {
+            try { threads = std::stoul(count); }
+            catch (const std::exception&) { return {false, "Bad thread count: " + count}; }
+        }
+
+        double value = req.graph.max_flow(source,sink,engine,threads);
 
         return {true,std::to_string(value)};
 
     }
+
+    private:
+    FlowEngine engine_;
 };
\ No newline at end of file
@@ -3,21 +3,42 @@
 #include <string>
 #include <sstream>
 
-// Strategy for computing strongly-connected components via Kosaraju's algorithm
+// Strategy for computing strongly-connected components (Kosaraju's algorithm by default)
 // Request<T> is assumed to carry a ready-to-use graph
 
-template <typename T>
-class SCC_Algo : public AlgorithmIO<T> {
+template <typename T, typename Storage = HashStorage>
+class SCC_Algo : public AlgorithmIO<T, Storage> {
 public:
-    virtual Response run(const Request<T>& req) override {
+    explicit SCC_Algo(SccEngine default_engine = SccEngine::kosaraju) : engine_(default_engine) {}
+
+    // Option engine=kosaraju|tarjan|parallel overrides the factory default; threads=N sets the
+    // cores used by the parallel engine (default: sized to the graph)
+    virtual Response run(const Request<T, Storage>& req) override {
 
-        std::vector<std::vector<T>> scc_res = req.graph.kosarajus_algorithm_scc();
+        SccEngine engine = engine_;
+        const std::string name = req.option("engine");
+        if (!name.empty()) {
+            try { engine = parse_scc_engine(name); }
+            catch (const std::invalid_argument& e) { return {false, e.what()}; }
+        }
+
+        std::size_t threads = 0;
+        const std::string count = req.option("threads");
+        if (!count.empty()) {
+            try { threads = std::stoul(count); }
+            catch (const std::exception&) { return {false, "Bad thread count: " + count}; }
+        }
+
+        std::vector<std::vector<T>> scc_res = req.graph.strongly_connected_components(engine, threads);
 
        
         std::ostringstream oss;
         oss << scc_res;
         return {true, oss.str()};
     }
+
+private:
+    SccEngine engine_;
 };
 
 // Overload operator<< for any ostream to print a list of SCCs
@@ -5,6 +5,8 @@
 #include <vector>
 #include <sstream>
 #include <optional>
+#include <map>
+#include <cctype>
 
 #include "../Q_1_to_4/Graph/Graph.hpp"
 #include "./Factory/Factory_Algorithms.hpp"
@@ -41,10 +43,18 @@ inline Request<T> parse_request(const std::string& raw, Graph<T>& graph) {
         start = static_cast<T>(std::stoi(tok));
     if (std::getline(in, tok, '|') && !tok.empty())
         source = static_cast<T>(std::stoi(tok));
-    if (std::getline(in, tok, '\n') && !tok.empty())
+    if (std::getline(in, tok, '|') && !tok.empty())
         sink = static_cast<T>(std::stoi(tok));
 
-    return { graph, std::move(name), start, source, sink };
+    // Remaining fields are options: key=value (e.g. maxflow||0|5|engine=dinic)
+    std::map<std::string, std::string> options;
+    while (std::getline(in, tok, '|')) {
+        while (!tok.empty() && std::isspace(static_cast<unsigned char>(tok.back()))) tok.pop_back();
+        const auto eq = tok.find('=');
+        if (eq != std::string::npos) options[tok.substr(0, eq)] = tok.substr(eq + 1);
+    }
+
+    return { graph, std::move(name), start, source, sink, std::move(options) };
 }
 
 
@@ -28,8 +28,8 @@ inline void send_menu(ServerSocketTCP& server, int client_fd) {
          << "2) euler       : euler|||\n"
          << "3) hamilton    : hamilton|<start_vertex>||\n"
          << "4) mst         : mst|<start_vertex>||\n"
-         << "5) scc         : scc|||\n"
-         << "6) maxflow     : maxflow||<source>|<sink>\n"
+         << "5) scc         : scc|||[|engine=tarjan][|threads=4]\n"
+         << "6) maxflow     : maxflow||<source>|<sink>[|engine=dinic][|threads=4]\n"
          << "Type 'exit' to disconnect.\n";
     server.send_to_client(client_fd, menu.str());
 }
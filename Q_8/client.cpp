@@ -1,5 +1,6 @@
 #include "../Q_6/network_interface.hpp"
 #include "../Q_7/Socket_class/Client_Socket.hpp"
+#include "../Q_1_to_4/Graph/Generators.hpp"
 
 #include <iostream>
 #include <string>
@@ -52,24 +53,18 @@ int main() {
                 );
 
                 // Generate and send edges
-                std::mt19937 rng(std::random_device{}());
-                std::uniform_real_distribution<double> prob_dist(0.0, 1.0);
-                std::uniform_int_distribution<int> weight_dist(1, max_weight);
-
-                for (int i = 0; i < n; ++i) {
-                    for (int j = 0; j < n; ++j) {
-                        if (i == j) continue;
-                        if (prob_dist(rng) <= p) {
-                            int w = weight_dist(rng);
-                            client.send_to_server(
-                                "edge|" + std::to_string(i) + "|" + std::to_string(j) + "|" + std::to_string(w) + "\n"
-                            );
-                            if (!directed) {
-                                client.send_to_server(
-                                    "edge|" + std::to_string(j) + "|" + std::to_string(i) + "|" + std::to_string(w) + "\n"
-                                );
-                            }
-                        }
+                // Each pair with probability p (an undirected pair once), via geometric skips instead of n² coin flips
+                namespace gen = Graph_implementation::generators;
+                const auto edges = gen::gnp<int>(static_cast<std::size_t>(std::max(n, 0)), p, directed, std::random_device{}(), gen::uniform_int_weight{1, max_weight});
+                for (const auto& [i, j, weight] : edges) {
+                    const int w = static_cast<int>(weight);
+                    client.send_to_server(
+                        "edge|" + std::to_string(i) + "|" + std::to_string(j) + "|" + std::to_string(w) + "\n"
+                    );
+                    if (!directed) {
+                        client.send_to_server(
+                            "edge|" + std::to_string(j) + "|" + std::to_string(i) + "|" + std::to_string(w) + "\n"
+                        );
                     }
                 }
             } else {
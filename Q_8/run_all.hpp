@@ -9,6 +9,7 @@
 #include <vector>
 #include <memory>
 #include <optional>
+#include <map>
 
 
 /*Shared Namespace for stage 8*/
@@ -44,7 +45,8 @@ static inline std::string run_all_algorithms(
     Graph& g,
     int n_from_init,
     std::optional<int> mf_source = {},
-    std::optional<int> mf_sink   = {}
+    std::optional<int> mf_sink   = {},
+    std::map<std::string, std::string> mf_options = {} // engine=ek|dinic|pr|ppr, threads=N (see MaxFlow)
 ) {
     std::ostringstream out;
 
@@ -86,6 +88,7 @@ static inline std::string run_all_algorithms(
                             /*start*/{},
                             /*source*/src,
                             /*sink*/sink);
+        req.options = std::move(mf_options);
         out << run_request(req) << "\n";
     }
 
@@ -15,6 +15,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <optional>
+#include <map>
 #include <cerrno>
 #include <csignal>
 #include <atomic>
@@ -50,7 +51,8 @@ static inline std::string tolower_copy(std::string s) {
 struct AlgoParams {
     std::optional<int> mf_source;
     std::optional<int> mf_sink;
-    void reset() { mf_source.reset(); mf_sink.reset(); }
+    std::map<std::string, std::string> mf_options; // key=value fields of the maxflow line (engine=, threads=)
+    void reset() { mf_source.reset(); mf_sink.reset(); mf_options.clear(); }
 };
 
 struct SharedState {
@@ -61,6 +63,7 @@ struct SharedState {
     std::unordered_map<int, std::shared_ptr<GraphT>> client_graphs;/*Hash map to map client-> graph*/
     std::unordered_map<int, int>                     graph_n;/*client-> desired amount of vertices*/
     std::unordered_map<int, AlgoParams>              params;/*client -> Max_Flow Paramters*/
+    std::unordered_map<int, std::vector<GraphT::edge_tuple>> pending_edges;/*client -> edges not yet built (flushed at commit)*/
 
     // per-client input buffer (accumulate by '\n')
     std::unordered_map<int, std::string>             inbuf;
@@ -128,6 +131,7 @@ static void process_line(const std::string& raw, int fd,
             S.client_graphs[fd] = std::make_shared<GraphT>(n, directed);
             S.graph_n[fd] = n;
             S.params[fd].reset();
+            S.pending_edges[fd].clear();
             S.inbuf[fd].clear();
         }
         std::cout << "Client " << fd << " init: n=" << n
@@ -144,14 +148,16 @@ static void process_line(const std::string& raw, int fd,
         std::getline(ss, tok, '|'); int v = std::stoi(tok);
         std::getline(ss, tok, '|'); double w = std::stod(tok);
 
-        std::shared_ptr<GraphT> g;
+        bool has_graph = false;
         {
+            // Buffer the edge; the graph is built in one add_edges() call at commit
             std::lock_guard<std::mutex> lk(S.state_mtx);
-            auto it = S.client_graphs.find(fd);
-            if (it != S.client_graphs.end()) g = it->second;
+            if (S.client_graphs.count(fd)) {
+                S.pending_edges[fd].emplace_back(u, v, w);
+                has_graph = true;
+            }
         }
-        if (g) g->add_edge(u, v, w);
-        else   server.send_to_client(fd, "ERR|Graph not initialized yet.\n");
+        if (!has_graph) server.send_to_client(fd, "ERR|Graph not initialized yet.\n");
         return;
     }
 
@@ -163,10 +169,17 @@ static void process_line(const std::string& raw, int fd,
         int src=-1, sink=-1;
         if (std::getline(ss, tok, '|') && !tok.empty()) src  = std::stoi(tok);
         if (std::getline(ss, tok, '|') && !tok.empty()) sink = std::stoi(tok);
+        std::map<std::string, std::string> options; // optional trailing fields: engine=ek|dinic|pr|ppr, threads=N
+        while (std::getline(ss, tok, '|')) {
+            trim(tok);
+            const auto eq = tok.find('=');
+            if (eq != std::string::npos) options[tok.substr(0, eq)] = tok.substr(eq + 1);
+        }
         if (src >= 0 && sink >= 0) {
             std::lock_guard<std::mutex> lk(S.state_mtx);
             S.params[fd].mf_source = src;
             S.params[fd].mf_sink   = sink;
+            S.params[fd].mf_options = std::move(options);
         }
         return;
     }
@@ -180,13 +193,16 @@ static void process_line(const std::string& raw, int fd,
     // ---------------------- COMMIT ----------------------
     if (cmd == "commit") {
         std::shared_ptr<GraphT> g;
+        std::vector<GraphT::edge_tuple> batch;
         int n_for_flow = 0;
         std::optional<int> mf_src, mf_sink;
+        std::map<std::string, std::string> mf_options;
 
         {
             std::lock_guard<std::mutex> lk(S.state_mtx);
             auto it = S.client_graphs.find(fd);
             if (it != S.client_graphs.end()) g = it->second;
+            batch.swap(S.pending_edges[fd]);
             auto itn = S.graph_n.find(fd);
             if (itn != S.graph_n.end()) n_for_flow = itn->second;
 
@@ -194,19 +210,21 @@ static void process_line(const std::string& raw, int fd,
             if (pit != S.params.end()) {
                 mf_src  = pit->second.mf_source;
                 mf_sink = pit->second.mf_sink;
+                mf_options = pit->second.mf_options;
             }
         }
 
         if (!g) { server.send_to_client(fd, "ERR|Graph not initialized yet.\n"); return; }
+        g->add_edges(batch);
 
         try {
-            std::string ans = lf_stage8::run_all_algorithms(*g, n_for_flow, mf_src, mf_sink);
+            std::string ans = lf_stage8::run_all_algorithms(*g, n_for_flow, mf_src, mf_sink, mf_options);
             server.send_to_client(fd, ans);
             server.send_to_client(fd,
                 "You can send a new graph now.\n"
                 "Start with: init|<n>|<directed:0/1>\n"
                 "Then edges: edge|<u>|<v>|<w>\n"
-                "Optionally set Max-Flow: maxflow|<source>|<sink>\n"
+                "Optionally set Max-Flow: maxflow|<source>|<sink>[|engine=dinic][|threads=4]\n"
                 "Finish with: commit\n");
         } catch (...) {
             try { server.send_to_client(fd, "Internal error while processing COMMIT.\n"); } catch (...) {}
@@ -242,6 +260,7 @@ static void worker_loop(ServerSocketTCP& server, SharedState& S) {
                 S.client_graphs.erase(fd);
                 S.graph_n.erase(fd);
                 S.params.erase(fd);
+                S.pending_edges.erase(fd);
                 S.inbuf.erase(fd);
                 std::cout << "Client " << fd << " closed.\n";
 
@@ -4,10 +4,10 @@
 // Strategy for finding a Hamiltonian cycle
 // T must support operator<< for serialization
 
-template <typename T>
-class HamiltonAlgo : public AlgorithmIO<T> {
+template <typename T, typename Storage = HashStorage>
+class HamiltonAlgo : public AlgorithmIO<T, Storage> {
 public:
-     virtual Response run(const Request<T>& req) override {
+     virtual Response run(const Request<T, Storage>& req) override {
         if(!req.start) 
            return {false,"Missing start"};
 
@@ -7,10 +7,25 @@
 // Strategy for computing an MST via Prim's algorithm (or arborescence if directed)
 // Request<T> is assumed to have std::optional<T> start
 
+// Streaming operator for the (from, to, weight) columns returned by spanning_edges()
+// Same format as the std::vector<Edge<T>> overload below
 template <typename T>
-class MSTAlgo : public AlgorithmIO<T> {
+std::ostream& operator<<(std::ostream& os, const WeightedEdgeList<T>& edges_list) {
+    os << "{\n";
+    for (std::size_t i = 0; i < edges_list.size(); ++i) {
+        os << "("
+           << edges_list.from(i) << ", "
+           << edges_list.to(i) << ", weight: "
+           << edges_list.weight(i) << ")\n";
+    }
+    os << "}\n";
+    return os;
+}
+
+template <typename T, typename Storage = HashStorage>
+class MSTAlgo : public AlgorithmIO<T, Storage> {
 public:
-    virtual Response run(const Request<T>& req) override {
+    virtual Response run(const Request<T, Storage>& req) override {
         if (!req.start.has_value()) {
             return {false, "Missing the starting vertex"};
         }
@@ -18,7 +33,7 @@ public:
 
         // For undirected graphs this returns a Prim MST.
         // For directed graphs this returns a minimum arborescence (rooted at 'first').
-        auto edges_list = req.graph.prims_algorithm(first);
+        auto edges_list = req.graph.spanning_edges(first);
 
         if (edges_list.empty()) {
             return {false, "No spanning tree/arborescence found from the given root"};
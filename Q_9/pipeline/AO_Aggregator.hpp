@@ -1,11 +1,13 @@
 #pragma once
 #include <unordered_map>
 #include <mutex>
+#include <memory>
 #include <sstream>
 #include "ActiveObject.hpp"
 #include "Result.hpp"
 #include "Response.hpp"
 #include "Constants.hpp"
+#include "Job.hpp"
 
 
 //==== Collection of each Stage's result ======
@@ -21,6 +23,7 @@ struct PartialSet {
     std::string mst, scc, ham, flow;
     bool ok_mst = false, ok_scc = false, ok_ham = false, ok_flow = false;
     std::string err_mst, err_scc, err_ham, err_flow;
+    std::shared_ptr<JobArena> arena; // kept alive until the flush, then released in one shot
 };
 
 class AO_Aggregator : public ActiveObject<Result> {
@@ -30,13 +33,15 @@ public:
 
     // New signature: register job with header text and directedness
     void register_job(const std::string& job_id, int client_fd,
-                      std::string header, bool directed)
+                      std::string header, bool directed,
+                      std::shared_ptr<JobArena> arena = nullptr)
     {
         std::lock_guard<std::mutex> lk(m_mtx);
         auto& ps = m_jobs[job_id];
         ps.client_fd   = client_fd;
         ps.graph_header = std::move(header);
         ps.directed    = directed;
+        ps.arena       = std::move(arena);
     }
 
 protected:
@@ -63,7 +68,7 @@ protected:
                                                     outgoing struct*/
             const int fd = ps.client_fd;
             std::string payload = format_payload(ps);
-            m_jobs.erase(it);
+            m_jobs.erase(it); // drops the job's arena reference
             lk.unlock();
             m_out.push(Outgoing{fd, std::move(payload)});
         }
@@ -27,8 +27,8 @@ protected:
         hdr << "===== Graph =====\n";
         hdr << job.graph->to_string_with_weights(false) << "\n\n";
 
-        // Register job with aggregator (client fd, header, directed)
-        m_agg.register_job(job.job_id, job.client_fd, hdr.str(), job.directed);
+        // Register job with aggregator (client fd, header, directed, arena)
+        m_agg.register_job(job.job_id, job.client_fd, hdr.str(), job.directed, job.arena);
 
         // Fan-out copies to all algo queues
         m_q_mst.push(job);
@@ -2,6 +2,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <map>
 
 // Real project includes (Factory/Strategy + Request/Response/AlgorithmIO)
 #include "../../Q_7/Strategy/AlgoIO.hpp"
@@ -18,13 +19,14 @@ static inline Response run_request_name(GraphT& g,
                                         const std::string& name,
                                         std::optional<int> start = {},
                                         std::optional<int> source = {},
-                                        std::optional<int> sink = {})
+                                        std::optional<int> sink = {},
+                                        std::map<std::string, std::string> options = {})
 {
     
 
-    Request<Vertex> req(g, name, start, source, sink);
-    std::unique_ptr<AlgorithmIO<Vertex>> algo =
-        AlgorithmsFactory<Vertex>::create(req);
+    Request<Vertex, GraphStorage> req(g, name, start, source, sink, std::move(options));
+    std::unique_ptr<AlgorithmIO<Vertex, GraphStorage>> algo =
+        AlgorithmsFactory<Vertex, GraphStorage>::create(req);
     if (!algo) {
         return {false, std::string("ERR|Unknown algorithm: ") + name + "\n"};
     }
@@ -33,10 +35,19 @@ static inline Response run_request_name(GraphT& g,
    
 }
 
+// Routes the algorithm temporaries of this thread into the job's arena for one stage
+// (global heap if the job has no arena)
+struct ScratchFor {
+    GI::arena::ScratchScope scope;
+    ScratchFor(const Job& job, AlgoKind kind)
+        : scope(job.arena ? job.arena->for_kind(kind) : nullptr) {}
+};
+
 //======Functions that returns the Result struct based on the Algorithm Respond struct=======
 
 inline Result run_mst(const Job& job) {
     Result r; r.job_id = job.job_id; r.kind = AlgoKind::MST;//Set the Result struct
+    ScratchFor scratch(job, AlgoKind::MST);
     try {
         const int first = job.graph->get_first();// get the first vertex
         Response rr = run_request_name(*job.graph, "mst", /*start=*/first);//Set the response fields
@@ -50,10 +61,11 @@ inline Result run_mst(const Job& job) {
 
 inline Result run_scc(const Job& job) {
     Result r; r.job_id = job.job_id; r.kind = AlgoKind::SCC;
+    ScratchFor scratch(job, AlgoKind::SCC);
     try {
-        Response rr = run_request_name(*job.graph, "scc");
+        Response rr = run_request_name(*job.graph, "scc", /*start*/{}, /*source*/{}, /*sink*/{}, job.scc_options);
         r.ok = rr.ok; r.value = rr.response;
-        if (!r.ok && r.value.empty()) r.error_msg = "SCC failed";
+        if (!r.ok) r.error_msg = r.value.empty() ? "SCC failed" : r.value; // e.g. unknown engine
     } catch (const std::exception& e) {
         r.ok = false; r.error_msg = e.what();
     }
@@ -62,6 +74,7 @@ inline Result run_scc(const Job& job) {
 
 inline Result run_hamilton(const Job& job) {
     Result r; r.job_id = job.job_id; r.kind = AlgoKind::HAMILTON;
+    ScratchFor scratch(job, AlgoKind::HAMILTON);
     try {
         const int first = job.graph->get_first();
         Response rr = run_request_name(*job.graph, "hamilton", /*start=*/first);
@@ -75,6 +88,7 @@ inline Result run_hamilton(const Job& job) {
 
 inline Result run_maxflow(const Job& job) {
     Result r; r.job_id = job.job_id; r.kind = AlgoKind::MAXFLOW;
+    ScratchFor scratch(job, AlgoKind::MAXFLOW);
     try {
         const std::optional<int> s = job.s;
         const std::optional<int> t = job.t;
@@ -82,9 +96,9 @@ inline Result run_maxflow(const Job& job) {
             r.ok = false; r.error_msg = "Missing s/t parameters for Max-Flow";
             return r;
         }
-        Response rr = run_request_name(*job.graph, "maxflow", /*start*/{}, s, t);
+        Response rr = run_request_name(*job.graph, "maxflow", /*start*/{}, s, t, job.flow_options);
         r.ok = rr.ok; r.value = rr.response;
-        if (!r.ok && r.value.empty()) r.error_msg = "Max-Flow failed";
+        if (!r.ok) r.error_msg = r.value.empty() ? "Max-Flow failed" : r.value; // e.g. unknown engine
     } catch (const std::exception& e) {
         r.ok = false; r.error_msg = e.what();
     }
@@ -1,26 +1,46 @@
 #pragma once
 #include <string>
 #include <optional>
+#include <map>
 #include <memory>
+#include <memory_resource>
+#include <cstddef>
 
 // Correct path to your Graph
 #include "../../Q_1_to_4/Graph/Graph.hpp"
+#include "Result.hpp"
+#include "Constants.hpp"
 
 // Mirror the aliases used in server.cpp
 namespace GI = Graph_implementation;
 using Vertex = int;
-using GraphT = GI::Graph<Vertex>;
+// Copy-on-write storage: the per-commit snapshot handed to the pipeline is O(1)
+using GraphStorage = GI::CowStorage;
+using GraphT = GI::Graph<Vertex, GraphStorage>;
 
 // Job represents a single client request ready for algorithm processing.
 namespace Q9 {
 
+// Scratch memory of one job: the algorithm temporaries of every stage are bump-allocated here
+// and freed together when the last owner (normally the aggregator, on flush) lets go.
+// One arena per stage, because the four stages of a job run concurrently on different threads
+// and a monotonic_buffer_resource is not thread-safe.
+struct JobArena {
+    std::pmr::monotonic_buffer_resource stage[REQUIRED_RESULTS_PER_JOB]; // indexed by AlgoKind
+
+    std::pmr::memory_resource* for_kind(AlgoKind kind) { return &stage[static_cast<std::size_t>(kind)]; }
+};
+
 struct Job {
     int client_fd = -1;                 // Target socket FD for response
     std::string job_id;                 // Unique identifier for fan-in
-    std::shared_ptr<GraphT> graph;      // Shared graph instance
+    std::shared_ptr<GraphT> graph;      // Shared graph snapshot (shares storage with the client's graph)
     std::optional<int> s;               // Max-Flow source (if provided)
     std::optional<int> t;               // Max-Flow sink (if provided)
+    std::map<std::string, std::string> flow_options; // Max-Flow options (engine=..., threads=...)
+    std::map<std::string, std::string> scc_options;  // SCC options (engine=..., threads=...)
     bool directed = true;               // Whether the graph is directed
+    std::shared_ptr<JobArena> arena;    // Per-job scratch memory (shared by the fan-out copies)
 
     Job() = default;                    // Default constructor
 
@@ -20,6 +20,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <optional>
+#include <map>
 #include <cerrno>
 #include <atomic>
 #include <csignal> // for signal handling
@@ -31,7 +32,8 @@ std::mutex g_mtx; // global mutex for shared state
 
 namespace GI = Graph_implementation;
 using Vertex = int;
-using GraphT = GI::Graph<Vertex>;
+using GraphStorage = GI::CowStorage;
+using GraphT = GI::Graph<Vertex, GraphStorage>;
 std::atomic<bool> stop_flag(false);// Global flag to stop the server
 // ----------------------------------------------------------------
 
@@ -52,12 +54,25 @@ static inline std::string tolower_copy(std::string s) {
                    [](unsigned char c){ return std::tolower(c); });
     return s;
 }
+// Remaining '|' fields of a command line as key=value options (engine=..., threads=...)
+static inline std::map<std::string, std::string> read_options(std::istringstream& ss) {
+    std::map<std::string, std::string> options;
+    std::string tok;
+    while (std::getline(ss, tok, '|')) {
+        trim(tok);
+        const auto eq = tok.find('=');
+        if (eq != std::string::npos) options[tok.substr(0, eq)] = tok.substr(eq + 1);
+    }
+    return options;
+}
 // -----------------------------------------------------------
 
 struct AlgoParams {
     std::optional<int> mf_source;
     std::optional<int> mf_sink;
-    void reset() { mf_source.reset(); mf_sink.reset(); }
+    std::map<std::string, std::string> mf_options;  // key=value fields of the maxflow line (engine=, threads=)
+    std::map<std::string, std::string> scc_options; // key=value fields of the scc line (engine=, threads=)
+    void reset() { mf_source.reset(); mf_sink.reset(); mf_options.clear(); scc_options.clear(); }
 };
 
 struct SharedState {
@@ -66,6 +81,7 @@ struct SharedState {
     std::unordered_map<int, std::shared_ptr<GraphT>> client_graphs;
     std::unordered_map<int, int>                      graph_n;
     std::unordered_map<int, AlgoParams>               params;
+    std::unordered_map<int, GI::GraphDelta<Vertex>>   pending_edges; // edge/del lines, applied as one delta at commit
     std::unordered_map<int, std::string>              inbuf;
 
     std::vector<int> pending_close;
@@ -124,6 +140,7 @@ static void process_line(const std::string& raw, int fd,
             S.client_graphs[fd] = std::make_shared<GraphT>(n, directed);
             S.graph_n[fd] = n;
             S.params[fd].reset();
+            S.pending_edges[fd].clear();
             S.inbuf[fd].clear();
         }
         SCOUT << "Client " << fd << " init: n=" << n
@@ -139,16 +156,36 @@ static void process_line(const std::string& raw, int fd,
         std::getline(ss, tok, '|'); int v = std::stoi(tok);
         std::getline(ss, tok, '|'); double w = std::stod(tok);
 
-        std::shared_ptr<GraphT> g;
+        bool has_graph = false;
         {
+            // Buffer the edge; the graph is built in one add_edges() call at commit
             std::lock_guard<std::mutex> lk(S.state_mtx);
-            auto it = S.client_graphs.find(fd);
-            if (it != S.client_graphs.end()) g =it->second;
+            if (S.client_graphs.count(fd)) {
+                S.pending_edges[fd].insert(u, v, w);
+                has_graph = true;
+            }
         }
-        if (g) g->add_edge(u, v, w);
-        else   server.send_to_client(fd, "ERR|Graph not initialized yet.\n");
-        
-        
+        if (!has_graph) server.send_to_client(fd, "ERR|Graph not initialized yet.\n");
+        return;
+    }
+
+    if (cmd == "del") {
+        std::istringstream ss(line);
+        std::string tok;
+        std::getline(ss, tok, '|');
+        std::getline(ss, tok, '|'); int u = std::stoi(tok);
+        std::getline(ss, tok, '|'); int v = std::stoi(tok);
+
+        bool has_graph = false;
+        {
+            // Deletions run before the insertions of the same commit, so a re-commit can re-weight edges
+            std::lock_guard<std::mutex> lk(S.state_mtx);
+            if (S.client_graphs.count(fd)) {
+                S.pending_edges[fd].erase(u, v);
+                has_graph = true;
+            }
+        }
+        if (!has_graph) server.send_to_client(fd, "ERR|Graph not initialized yet.\n");
         return;
     }
 
@@ -159,23 +196,38 @@ static void process_line(const std::string& raw, int fd,
         int src=-1, sink=-1;
         if (std::getline(ss, tok, '|') && !tok.empty()) src  = std::stoi(tok);
         if (std::getline(ss, tok, '|') && !tok.empty()) sink = std::stoi(tok);
+        auto options = read_options(ss); // optional trailing fields: engine=ek|dinic|pr|ppr, threads=N
         if (src >= 0 && sink >= 0) {
             std::lock_guard<std::mutex> lk(S.state_mtx);
             S.params[fd].mf_source = src;
             S.params[fd].mf_sink   = sink;
+            S.params[fd].mf_options = std::move(options);
         }
         return;
     }
 
-    if (cmd == "print" || cmd == "connected" || cmd == "scc" ||
+    // scc|engine=kosaraju|tarjan|parallel[|threads=N] picks the SCC stage's engine for the next commit
+    if (cmd == "scc") {
+        std::istringstream ss(line);
+        std::string tok;
+        std::getline(ss, tok, '|'); // "scc"
+        auto options = read_options(ss);
+        std::lock_guard<std::mutex> lk(S.state_mtx);
+        S.params[fd].scc_options = std::move(options);
+        return;
+    }
+
+    if (cmd == "print" || cmd == "connected" ||
         cmd == "mst"   || cmd == "hamilton") {
         return;
     }
 
     if (cmd == "commit") {
         std::shared_ptr<GraphT> g;
+        GI::GraphDelta<Vertex> batch;
         int n_for_flow = 0;
         std::optional<int> mf_src, mf_sink;
+        std::map<std::string, std::string> mf_options, scc_options;
         bool is_dir = true;
 
         {
@@ -185,16 +237,20 @@ static void process_line(const std::string& raw, int fd,
                 g = it->second;
                 is_dir = g->is_directed();
             }
+            std::swap(batch, S.pending_edges[fd]);
             auto itn = S.graph_n.find(fd);
             if (itn != S.graph_n.end()) n_for_flow = itn->second;
             auto pit = S.params.find(fd);
             if (pit != S.params.end()) {
                 mf_src  = pit->second.mf_source;
                 mf_sink = pit->second.mf_sink;
+                mf_options = pit->second.mf_options;
+                scc_options = pit->second.scc_options;
             }
         }
 
         if (!g) { server.send_to_client(fd, "ERR|Graph not initialized yet.\n"); return; }
+        g->apply(batch); // one version step per commit
 
         // Defaults like stage 8 (0 .. n-1)
         const int default_s = 0;
@@ -203,10 +259,13 @@ static void process_line(const std::string& raw, int fd,
         Q9::Job job;//Creating a Job struct from the client's input
         job.client_fd = fd;
         job.job_id    = "J" + std::to_string(job_counter++);
-        job.graph     = std::make_shared<GraphT>(*g);
+        job.graph     = std::make_shared<GraphT>(*g); // O(1) copy-on-write snapshot
         job.directed  = is_dir;
+        job.arena     = std::make_shared<Q9::JobArena>(); // scratch memory of the four stages
         job.s         = mf_src.has_value()  ? mf_src  : std::optional<int>(default_s);
         job.t         = mf_sink.has_value() ? mf_sink : std::optional<int>(default_t);
+        job.flow_options = std::move(mf_options);
+        job.scc_options = std::move(scc_options);
 
         pipeline.submit(job);
 
@@ -251,6 +310,7 @@ static void worker_loop(ServerSocketTCP& server, SharedState& S,
                 S.client_graphs.erase(fd);
                 S.graph_n.erase(fd);
                 S.params.erase(fd);
+                S.pending_edges.erase(fd);
                 S.inbuf.erase(fd);
                 SCOUT << "Client " << fd << " closed.\n";
             }